@@ -0,0 +1,139 @@
+/* -----------------------------------------------------------------------------
+ * Copyright (c) 2026 ARM Ltd.
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software. Permission is granted to anyone to use this
+ * software for any purpose, including commercial applications, and to alter
+ * it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V1.00
+ *
+ * Project:      Compare and Blank Check of memory-mapped Flash
+ * --------------------------------------------------------------------------- */
+
+/* History:
+ *  Version 1.00
+ *    Initial release
+ */
+
+/* Flash is read 16 bytes per loop as four words. The XOR of each word
+ * with the data or the pattern is combined, so a single test checks all
+ * 16 bytes. A block with a mismatch is scanned again byte by byte to
+ * locate the first failing byte. The Flash address is word aligned before
+ * the block loop, the data buffer may have any alignment. Words are read
+ * with memcpy into locals: the compiler issues a single LDR (unaligned
+ * LDR is allowed for the buffer on Armv7-M and Armv8-M Mainline) without
+ * alignment or aliasing assumptions about the byte pointers.
+ *
+ * An algorithm with Verify and BlankCheck replaces the read-back of the
+ * debugger: the debugger calls them instead of reading the memory itself.
+ *
+ * Host unit tests and benchmarks: Test/FlashCompareTest.c.
+ */
+
+#ifndef FLASH_COMPARE_H
+#define FLASH_COMPARE_H
+
+#include <stdint.h>
+#include <string.h>
+
+/*
+ *  Read a word from any address
+ *    Parameter:      p:    Address
+ *    Return Value:   Word (target byte order)
+ */
+static __inline uint32_t FlashRd32 (const unsigned char *p) {
+  uint32_t w;
+
+  memcpy(&w, p, sizeof(w));
+
+  return (w);
+}
+
+/*
+ *  Compare Flash with Buffer
+ *    Parameter:      mem:  Flash Address
+ *                    buf:  Data
+ *                    sz:   Size (in bytes)
+ *    Return Value:   Offset of first mismatch, sz - Match
+ */
+static __inline unsigned long FlashCompare (const unsigned char *mem, const unsigned char *buf, unsigned long sz) {
+  unsigned long i = 0;
+  unsigned long n;
+
+  while ((i < sz) && (((uintptr_t)(mem + i) & 3) != 0)) {
+    if (mem[i] != buf[i]) {
+      return (i);
+    }
+    i++;
+  }
+
+  for (n = (sz - i) / 16; n != 0; n--) {
+    if (((FlashRd32(mem + i     ) ^ FlashRd32(buf + i     )) |
+         (FlashRd32(mem + i +  4) ^ FlashRd32(buf + i +  4)) |
+         (FlashRd32(mem + i +  8) ^ FlashRd32(buf + i +  8)) |
+         (FlashRd32(mem + i + 12) ^ FlashRd32(buf + i + 12))) != 0) {
+      break;                               // locate mismatch below
+    }
+    i += 16;
+  }
+
+  for (; i < sz; i++) {
+    if (mem[i] != buf[i]) {
+      return (i);
+    }
+  }
+
+  return (sz);
+}
+
+/*
+ *  Blank Check of Flash
+ *    Parameter:      mem:  Flash Address
+ *                    sz:   Size (in bytes)
+ *                    pat:  Pattern
+ *    Return Value:   Offset of first byte differing from pat, sz - Blank
+ */
+static __inline unsigned long FlashBlank (const unsigned char *mem, unsigned long sz, unsigned char pat) {
+  uint32_t p = pat * 0x01010101UL;
+  unsigned long i = 0;
+  unsigned long n;
+
+  while ((i < sz) && (((uintptr_t)(mem + i) & 3) != 0)) {
+    if (mem[i] != pat) {
+      return (i);
+    }
+    i++;
+  }
+
+  for (n = (sz - i) / 16; n != 0; n--) {
+    if (((FlashRd32(mem + i     ) ^ p) | (FlashRd32(mem + i +  4) ^ p) |
+         (FlashRd32(mem + i +  8) ^ p) | (FlashRd32(mem + i + 12) ^ p)) != 0) {
+      break;                               // locate mismatch below
+    }
+    i += 16;
+  }
+
+  for (; i < sz; i++) {
+    if (mem[i] != pat) {
+      return (i);
+    }
+  }
+
+  return (sz);
+}
+
+#endif /* FLASH_COMPARE_H */
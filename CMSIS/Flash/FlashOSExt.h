@@ -0,0 +1,60 @@
+/* -----------------------------------------------------------------------------
+ * Copyright (c) 2026 ARM Ltd.
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software. Permission is granted to anyone to use this
+ * software for any purpose, including commercial applications, and to alter
+ * it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V1.00
+ *
+ * Project:      Flash Programming Functions of this pack beyond FlashOS
+ * --------------------------------------------------------------------------- */
+
+/* History:
+ *  Version 1.00
+ *    Initial release
+ */
+
+/* These functions are not part of the FlashOS interface (FlashOS.h, VERS 1).
+ * A debugger does not call them; a host that knows this pack finds them by
+ * their FLM symbols. Algorithms without them are still complete.
+ */
+
+#ifndef FLASH_OS_EXT_H
+#define FLASH_OS_EXT_H
+
+// Asynchronous Flash Programming Functions
+// Start* returns 0 - OK, 1 - Failed; PollOperation returns OP_xxx.
+// Other Flash functions wait until a started operation is finished.
+#define OP_DONE    0           // Operation finished successfully
+#define OP_ERROR   1           // Operation failed
+#define OP_BUSY    2           // Operation in progress
+
+extern          int  StartErase     (unsigned long adr);  // Start Sector Erase
+extern          int  StartEraseChip (void);               // Start Chip Erase
+extern          int  PollOperation  (void);               // Status of started Operation
+
+// Digest Function
+// Calculates SHA-256 of the Flash content; the host compares it with the
+// digest of the image and verifies failing ranges with Verify.
+#define DIGEST_SIZE 32         // SHA-256 size in bytes
+
+extern          int  Digest         (unsigned long adr,   // Digest Function
+                                     unsigned long sz,    // Return 0 - OK, 1 - Failed
+                                     unsigned char *buf); // DIGEST_SIZE bytes
+
+#endif /* FLASH_OS_EXT_H */
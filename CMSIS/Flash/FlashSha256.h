@@ -0,0 +1,146 @@
+/* -----------------------------------------------------------------------------
+ * Copyright (c) 2026 ARM Ltd.
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software. Permission is granted to anyone to use this
+ * software for any purpose, including commercial applications, and to alter
+ * it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V1.00
+ *
+ * Project:      SHA-256 of memory-mapped Flash (software)
+ * --------------------------------------------------------------------------- */
+
+/* History:
+ *  Version 1.00
+ *    Initial release
+ */
+
+/* Used by Digest on devices without HASH peripheral. The K table is
+ * constant data in PrgCode; no initialized variables are used.
+ */
+
+#ifndef FLASH_SHA256_H
+#define FLASH_SHA256_H
+
+#define FLASH_SHA256_SIZE      32          // Digest size in bytes
+
+#define SHA_ROR(x, n)          (((x) >> (n)) | ((x) << (32 - (n))))
+
+static const unsigned long FlashSha256K[64] = {
+  0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1, 0x923F82A4, 0xAB1C5ED5,
+  0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3, 0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174,
+  0xE49B69C1, 0xEFBE4786, 0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+  0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147, 0x06CA6351, 0x14292967,
+  0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13, 0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85,
+  0xA2BFE8A1, 0xA81A664B, 0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+  0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A, 0x5B9CCA4F, 0x682E6FF3,
+  0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208, 0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
+/*
+ *  Process one 64-byte Block
+ *    Parameter:      h:    Hash state (8 words)
+ *                    p:    Block data
+ */
+static void FlashSha256Block (unsigned long *h, const unsigned char *p) {
+  unsigned long w[64];
+  unsigned long a, b, c, d, e, f, g, k;
+  unsigned long t1, t2;
+  unsigned long i;
+
+  for (i = 0; i < 16; i++) {
+    w[i] = ((unsigned long)p[4*i] << 24) | ((unsigned long)p[4*i+1] << 16) |
+           ((unsigned long)p[4*i+2] << 8) |  (unsigned long)p[4*i+3];
+  }
+  for (i = 16; i < 64; i++) {
+    t1 = SHA_ROR(w[i-2], 17) ^ SHA_ROR(w[i-2], 19) ^ (w[i-2] >> 10);
+    t2 = SHA_ROR(w[i-15], 7) ^ SHA_ROR(w[i-15], 18) ^ (w[i-15] >> 3);
+    w[i] = (t1 + w[i-7] + t2 + w[i-16]) & 0xFFFFFFFF;
+  }
+
+  a = h[0]; b = h[1]; c = h[2]; d = h[3];
+  e = h[4]; f = h[5]; g = h[6]; k = h[7];
+
+  for (i = 0; i < 64; i++) {
+    t1 = k + (SHA_ROR(e, 6) ^ SHA_ROR(e, 11) ^ SHA_ROR(e, 25)) +
+         ((e & f) ^ (~e & g)) + FlashSha256K[i] + w[i];
+    t2 = (SHA_ROR(a, 2) ^ SHA_ROR(a, 13) ^ SHA_ROR(a, 22)) +
+         ((a & b) ^ (a & c) ^ (b & c));
+    k = g;
+    g = f;
+    f = e;
+    e = (d + t1) & 0xFFFFFFFF;
+    d = c;
+    c = b;
+    b = a;
+    a = (t1 + t2) & 0xFFFFFFFF;
+  }
+
+  h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+  h[4] += e; h[5] += f; h[6] += g; h[7] += k;
+}
+
+/*
+ *  Calculate SHA-256
+ *    Parameter:      mem:  Data Address
+ *                    sz:   Size (in bytes)
+ *                    dgst: Digest (FLASH_SHA256_SIZE bytes)
+ */
+static void FlashSha256 (const unsigned char *mem, unsigned long sz, unsigned char *dgst) {
+  unsigned long h[8];
+  unsigned char blk[64];
+  unsigned long n, i;
+
+  h[0] = 0x6A09E667; h[1] = 0xBB67AE85; h[2] = 0x3C6EF372; h[3] = 0xA54FF53A;
+  h[4] = 0x510E527F; h[5] = 0x9B05688C; h[6] = 0x1F83D9AB; h[7] = 0x5BE0CD19;
+
+  for (n = sz; n >= 64; n -= 64) {
+    FlashSha256Block(h, mem);
+    mem += 64;
+  }
+
+  /* last data, 0x80 and bit length (at most 2^32 bytes) */
+  for (i = 0; i < n; i++) {
+    blk[i] = mem[i];
+  }
+  blk[i++] = 0x80;
+  if (i > 56) {
+    for (; i < 64; i++) {
+      blk[i] = 0;
+    }
+    FlashSha256Block(h, blk);
+    i = 0;
+  }
+  for (; i < 59; i++) {
+    blk[i] = 0;
+  }
+  blk[59] = (unsigned char)(sz >> 29);
+  blk[60] = (unsigned char)(sz >> 21);
+  blk[61] = (unsigned char)(sz >> 13);
+  blk[62] = (unsigned char)(sz >>  5);
+  blk[63] = (unsigned char)(sz <<  3);
+  FlashSha256Block(h, blk);
+
+  for (i = 0; i < 8; i++) {
+    dgst[4*i]   = (unsigned char)(h[i] >> 24);
+    dgst[4*i+1] = (unsigned char)(h[i] >> 16);
+    dgst[4*i+2] = (unsigned char)(h[i] >>  8);
+    dgst[4*i+3] = (unsigned char)(h[i]      );
+  }
+}
+
+#endif /* FLASH_SHA256_H */
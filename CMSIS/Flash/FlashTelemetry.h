@@ -0,0 +1,265 @@
+/* -----------------------------------------------------------------------------
+ * Copyright (c) 2026 ARM Ltd.
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software. Permission is granted to anyone to use this
+ * software for any purpose, including commercial applications, and to alter
+ * it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V1.00
+ *
+ * Project:      Telemetry for Flash drivers (optional)
+ * --------------------------------------------------------------------------- */
+
+/* History:
+ *  Version 1.00
+ *    Initial release
+ */
+
+/* Telemetry is compiled in with FLASH_TELEMETRY defined, otherwise all
+ * macros expand to the plain code. The FlashTelemetry object is placed in
+ * PrgData; the host locates it by its symbol in the FLM and reads it after
+ * the session. Cycle counts are taken from DWT_CYCCNT. A busy wait is
+ * added to busyHist only if its condition was true at least once, so polls
+ * of an already finished operation do not fill the low buckets.
+ *
+ * FLASH_TELEMETRY_ITM additionally emits an ITM event at entry and exit of
+ * every function, so that flash operations can be followed live over SWO.
+ * Each event is written as four words to consecutive stimulus ports; the
+ * event word on the base port is written last and completes the event:
+ *   port + 1: Begin: address,  End: result (0 - OK, 1 - Failed)
+ *   port + 2: Begin: size,     End: cycles spent in the function
+ *   port + 3: DWT_CYCCNT
+ *   port + 0: event word, bits 0..7: function, bits 8..15: 1 - Begin, 2 - End
+ * Events are only written when the debugger has enabled ITM and the ports.
+ * If a stimulus port does not accept a word within FLASH_TLM_ITM_TIMEOUT
+ * polls (SWO not drained), the rest of the event is dropped and counted in
+ * itmDrops; an event without its event word is incomplete for the host.
+ * FlashTelemetry.py decodes the telemetry block and the ITM events.
+ */
+
+#ifndef FLASH_TELEMETRY_H
+#define FLASH_TELEMETRY_H
+
+#define FLASH_TLM_MAGIC        0x544C4D31  // "TLM1", block is valid
+
+// Functions with cycle statistics
+#define FLASH_TLM_INIT         0
+#define FLASH_TLM_UNINIT       1
+#define FLASH_TLM_ERASECHIP    2
+#define FLASH_TLM_ERASESECTOR  3
+#define FLASH_TLM_PROGRAMPAGE  4
+#define FLASH_TLM_VERIFY       5
+#define FLASH_TLM_BLANKCHECK   6
+#define FLASH_TLM_DIGEST       7
+#define FLASH_TLM_FNC_NUM      8
+
+#define FLASH_TLM_HIST_NUM     32          // log2 buckets of busy wait cycles
+#define FLASH_TLM_ERR_NUM      32          // error flags (status register bits)
+
+// Init phases with timestamp (OSPI)
+#define FLASH_TLM_PH_SYSINIT   0           // SystemInit
+#define FLASH_TLM_PH_CLOCK     1           // SystemClock_Config
+#define FLASH_TLM_PH_MSP       2           // GPIO/clock setup of the interface
+#define FLASH_TLM_PH_OSPI      3           // Interface initialization
+#define FLASH_TLM_PH_RESET     4           // Memory reset
+#define FLASH_TLM_PH_READY     5           // Memory ready polling
+#define FLASH_TLM_PH_CONFIG    6           // Memory configuration (e.g. DOPI entry)
+#define FLASH_TLM_PH_NUM       7
+
+// ITM events
+#ifndef FLASH_TLM_ITM_PORT
+#define FLASH_TLM_ITM_PORT     8           // Base stimulus port (4 ports used)
+#endif
+#ifndef FLASH_TLM_ITM_TIMEOUT
+#define FLASH_TLM_ITM_TIMEOUT  1000        // Polls of a busy stimulus port
+#endif
+#define FLASH_TLM_EV_BEGIN     1
+#define FLASH_TLM_EV_END       2
+
+#if defined FLASH_TELEMETRY_ITM && !defined FLASH_TELEMETRY
+#define FLASH_TELEMETRY
+#endif
+
+typedef struct {
+  unsigned long magic;                           // FLASH_TLM_MAGIC
+  unsigned long calls    [FLASH_TLM_FNC_NUM];    // Number of calls
+  unsigned long cycles   [FLASH_TLM_FNC_NUM];    // Accumulated cycles
+  unsigned long cyclesMax[FLASH_TLM_FNC_NUM];    // Longest call in cycles
+  unsigned long bytes    [FLASH_TLM_FNC_NUM];    // Accumulated size argument (bytes / cycles = throughput)
+  unsigned long busyHist [FLASH_TLM_HIST_NUM];   // Busy waits, bucket n: 2^n <= cycles < 2^(n+1)
+  unsigned long errors;                          // Number of failed calls
+  unsigned long errCount [FLASH_TLM_ERR_NUM];    // Errors per flag, index n: status register bit n
+  unsigned long modeSwitches;                    // Interface mode switches (OSPI)
+  unsigned long itmDrops;                        // ITM events dropped (FLASH_TELEMETRY_ITM)
+  unsigned long initPhase[FLASH_TLM_PH_NUM];     // Last Init: cycles from entry to end of phase
+  unsigned long fnc;                             // Function in progress
+  unsigned long tStart;                          // Cycle count at function entry
+} FlashTelemetry_t;
+
+#if defined FLASH_TELEMETRY
+
+#define FLASH_TLM_DEMCR        (*((volatile unsigned long *)0xE000EDFC))
+#define FLASH_TLM_DWT_CTRL     (*((volatile unsigned long *)0xE0001000))
+#define FLASH_TLM_DWT_CYCCNT   (*((volatile unsigned long *)0xE0001004))
+#define FLASH_TLM_ITM_STIM(n)  (*((volatile unsigned long *)(0xE0000000 + (4 * (n)))))
+#define FLASH_TLM_ITM_TER      (*((volatile unsigned long *)0xE0000E00))
+#define FLASH_TLM_ITM_TCR      (*((volatile unsigned long *)0xE0000E80))
+
+extern FlashTelemetry_t FlashTelemetry;
+
+#if defined FLASH_TELEMETRY_ITM
+static __inline int FlashTlmItmPut (unsigned long port, unsigned long val) {
+  unsigned long n;
+
+  for (n = FLASH_TLM_ITM_TIMEOUT; n != 0; n--) {
+    if ((FLASH_TLM_ITM_STIM(port) & 1UL) != 0) {   // FIFO ready
+      FLASH_TLM_ITM_STIM(port) = val;
+      return (1);
+    }
+  }
+  return (0);
+}
+
+static __inline void FlashTlmItm (unsigned long ev, unsigned long fnc, unsigned long p1, unsigned long p2) {
+  if (((FLASH_TLM_ITM_TCR & 1UL) == 0) ||                             // ITMENA
+      (((FLASH_TLM_ITM_TER >> FLASH_TLM_ITM_PORT) & 0xFUL) != 0xFUL)) {
+    return;
+  }
+  if ((FlashTlmItmPut(FLASH_TLM_ITM_PORT + 1, p1)                   == 0) ||
+      (FlashTlmItmPut(FLASH_TLM_ITM_PORT + 2, p2)                   == 0) ||
+      (FlashTlmItmPut(FLASH_TLM_ITM_PORT + 3, FLASH_TLM_DWT_CYCCNT) == 0) ||
+      (FlashTlmItmPut(FLASH_TLM_ITM_PORT,     fnc | (ev << 8))      == 0)) {
+    FlashTelemetry.itmDrops++;
+  }
+}
+#else
+#define FlashTlmItm(ev, fnc, p1, p2)
+#endif
+
+static __inline void FlashTlmBegin (unsigned long fnc, unsigned long adr, unsigned long sz) {
+  unsigned long *p;
+  unsigned long  n;
+
+  if (FlashTelemetry.magic != FLASH_TLM_MAGIC) {
+    /* no scatter loader: PrgData content is undefined after download */
+    p = (unsigned long *)&FlashTelemetry;
+    for (n = 0; n < (sizeof(FlashTelemetry) / 4); n++) {
+      p[n] = 0;
+    }
+    FlashTelemetry.magic = FLASH_TLM_MAGIC;
+  }
+
+  FLASH_TLM_DEMCR    |= (1UL << 24);       // TRCENA
+  FLASH_TLM_DWT_CTRL |=  1UL;              // CYCCNTENA
+
+  FlashTlmItm(FLASH_TLM_EV_BEGIN, fnc, adr, sz);
+
+  FlashTelemetry.bytes[fnc] += sz;
+
+  FlashTelemetry.fnc    = fnc;
+  FlashTelemetry.tStart = FLASH_TLM_DWT_CYCCNT;
+}
+
+static __inline void FlashTlmEnd (unsigned long fnc, unsigned long fail) {
+  unsigned long t = FLASH_TLM_DWT_CYCCNT - FlashTelemetry.tStart;
+
+  FlashTelemetry.calls [fnc]++;
+  FlashTelemetry.cycles[fnc] += t;
+  if (t > FlashTelemetry.cyclesMax[fnc]) {
+    FlashTelemetry.cyclesMax[fnc] = t;
+  }
+  if (fail != 0) {
+    FlashTelemetry.errors++;
+  }
+  FlashTelemetry.fnc = FLASH_TLM_FNC_NUM;         // no function in progress
+
+  FlashTlmItm(FLASH_TLM_EV_END, fnc, (fail != 0), t);
+}
+
+static __inline int FlashTlmRet (unsigned long fnc, int rc) {
+  FlashTlmEnd(fnc, (rc != 0));
+  return (rc);
+}
+
+static __inline unsigned long FlashTlmRetAdr (unsigned long fnc, unsigned long res, unsigned long ok) {
+  FlashTlmEnd(fnc, (res != ok));
+  return (res);
+}
+
+static __inline void FlashTlmPhase (unsigned long phase) {
+  if (FlashTelemetry.fnc == FLASH_TLM_INIT) {
+    FlashTelemetry.initPhase[phase] = FLASH_TLM_DWT_CYCCNT - FlashTelemetry.tStart;
+  }
+}
+
+static __inline long FlashTlmStep (long rc, unsigned long phase) {
+  FlashTlmPhase(phase);
+  return (rc);
+}
+
+static __inline void FlashTlmErr (unsigned long flags) {
+  unsigned long n;
+
+  for (n = 0; flags != 0; n++) {
+    if ((flags & 1UL) != 0) {
+      FlashTelemetry.errCount[n]++;
+    }
+    flags >>= 1;
+  }
+}
+
+static __inline void FlashTlmBusy (unsigned long t) {
+  unsigned long n = 0;
+
+  while (t >>= 1) {
+    n++;
+  }
+  FlashTelemetry.busyHist[n]++;
+}
+
+#define FLASH_TLM_BEGIN(fnc, adr, sz)    FlashTlmBegin((fnc), (adr), (sz))
+#define FLASH_TLM_RET(fnc, rc)           FlashTlmRet((fnc), (rc))
+#define FLASH_TLM_RET_ADR(fnc, res, ok)  FlashTlmRetAdr((fnc), (res), (ok))
+#define FLASH_TLM_ERR(flags)             FlashTlmErr(flags)
+#define FLASH_TLM_MODE()                 (FlashTelemetry.modeSwitches++)
+#define FLASH_TLM_PHASE(phase)           FlashTlmPhase(phase)
+#define FLASH_TLM_STEP(expr, phase)      FlashTlmStep((long)(expr), (phase))
+#define FLASH_TLM_SPIN(cond)             do {                                                 \
+                                           unsigned long t_ = FLASH_TLM_DWT_CYCCNT;           \
+                                           unsigned long w_ = 0;                              \
+                                           while (cond) {                                     \
+                                             w_ = 1;                                          \
+                                           }                                                  \
+                                           if (w_ != 0) {                                     \
+                                             FlashTlmBusy(FLASH_TLM_DWT_CYCCNT - t_);         \
+                                           }                                                  \
+                                         } while (0)
+
+#else
+
+#define FLASH_TLM_BEGIN(fnc, adr, sz)
+#define FLASH_TLM_RET(fnc, rc)           (rc)
+#define FLASH_TLM_RET_ADR(fnc, res, ok)  (res)
+#define FLASH_TLM_ERR(flags)
+#define FLASH_TLM_MODE()
+#define FLASH_TLM_PHASE(phase)
+#define FLASH_TLM_STEP(expr, phase)      (expr)
+#define FLASH_TLM_SPIN(cond)             while (cond)
+
+#endif /* FLASH_TELEMETRY */
+
+#endif /* FLASH_TELEMETRY_H */
@@ -0,0 +1,161 @@
+#!/usr/bin/env python3
+# -----------------------------------------------------------------------------
+# Copyright (c) 2026 ARM Ltd.
+#
+# This software is provided 'as-is', without any express or implied warranty.
+# In no event will the authors be held liable for any damages arising from
+# the use of this software. Permission is granted to anyone to use this
+# software for any purpose, including commercial applications, and to alter
+# it and redistribute it freely, subject to the following restrictions:
+#
+# 1. The origin of this software must not be misrepresented; you must not
+#    claim that you wrote the original software. If you use this software in
+#    a product, an acknowledgment in the product documentation would be
+#    appreciated but is not required.
+#
+# 2. Altered source versions must be plainly marked as such, and must not be
+#    misrepresented as being the original software.
+#
+# 3. This notice may not be removed or altered from any source distribution.
+#
+#
+# $Date:        18. October 2026
+# $Revision:    V1.00
+#
+# Project:      Host decoder for Flash driver telemetry (FlashTelemetry.h)
+# -----------------------------------------------------------------------------
+#
+# Usage:
+#   FlashTelemetry.py block <file>            FlashTelemetry memory dump
+#   FlashTelemetry.py itm   <file> [port]     raw SWO (ITM) capture
+#
+# The memory dump is the FlashTelemetry object read from the address of its
+# symbol in the FLM (sizeof(FlashTelemetry_t), little endian). The SWO
+# capture is the byte stream of the trace port (e.g. a UART/NRZ capture);
+# port is FLASH_TLM_ITM_PORT (default 8).
+
+import struct
+import sys
+
+FNC = ["Init", "UnInit", "EraseChip", "EraseSector", "ProgramPage",
+       "Verify", "BlankCheck", "Digest"]
+PHASE = ["SystemInit", "SystemClock", "Msp", "OSPI", "Reset", "Ready", "Config"]
+
+MAGIC    = 0x544C4D31
+FNC_NUM  = len(FNC)
+HIST_NUM = 32
+ERR_NUM  = 32
+
+# STM32L5xx FLASH_NSSR/SECSR error flags (FLASH_PGERR)
+ERR_NAME = {1: "OPERR", 3: "PROGERR", 4: "WRPERR", 5: "PGAERR",
+            6: "SIZERR", 7: "PGSERR", 13: "OPTWERR"}
+PH_NUM   = len(PHASE)
+
+# FlashTelemetry_t, 32-bit words in declaration order
+LAYOUT = [("magic", 1), ("calls", FNC_NUM), ("cycles", FNC_NUM),
+          ("cyclesMax", FNC_NUM), ("bytes", FNC_NUM), ("busyHist", HIST_NUM),
+          ("errors", 1), ("errCount", ERR_NUM), ("modeSwitches", 1), ("itmDrops", 1),
+          ("initPhase", PH_NUM), ("fnc", 1), ("tStart", 1)]
+
+
+def fnc_name(n):
+    return FNC[n] if n < FNC_NUM else "fnc%d" % n
+
+
+def decode_block(data):
+    words = sum(n for _, n in LAYOUT)
+    if len(data) < 4 * words:
+        sys.exit("dump has %d bytes, FlashTelemetry_t has %d" % (len(data), 4 * words))
+    w = struct.unpack_from("<%dI" % words, data)
+    t, i = {}, 0
+    for name, n in LAYOUT:
+        t[name] = w[i] if n == 1 else list(w[i:i + n])
+        i += n
+    if t["magic"] != MAGIC:
+        sys.exit("no valid telemetry block (magic 0x%08X)" % t["magic"])
+
+    print("%-12s %8s %14s %12s %12s %10s" %
+          ("function", "calls", "cycles", "avg", "max", "bytes/cyc"))
+    for n in range(FNC_NUM):
+        calls = t["calls"][n]
+        if calls == 0:
+            continue
+        cyc = t["cycles"][n]
+        rate = ("%.4f" % (t["bytes"][n] / cyc)) if (cyc and t["bytes"][n]) else "-"
+        print("%-12s %8u %14u %12u %12u %10s" %
+              (FNC[n], calls, cyc, cyc // calls, t["cyclesMax"][n], rate))
+    print("errors %u, mode switches %u, ITM drops %u" %
+          (t["errors"], t["modeSwitches"], t["itmDrops"]))
+    for n, cnt in enumerate(t["errCount"]):
+        if cnt:
+            print("  %-8s (bit %2u): %u" % (ERR_NAME.get(n, "-"), n, cnt))
+
+    print("busy waits (cycles):")
+    for n, cnt in enumerate(t["busyHist"]):
+        if cnt:
+            print("  %10u .. %10u: %u" % (1 << n, (2 << n) - 1, cnt))
+
+    if any(t["initPhase"]):
+        print("last Init (cycles from entry):")
+        for n, cyc in enumerate(t["initPhase"]):
+            print("  %-12s %10u" % (PHASE[n], cyc))
+
+
+def itm_packets(data):
+    """Yields (port, value) of the ITM software source packets."""
+    i, size = 0, len(data)
+    while i < size:
+        h = data[i]
+        i += 1
+        if h in (0x00, 0x80, 0x70):                # synchronization, overflow
+            continue
+        if (h & 0x03) != 0:                        # source packet
+            n = (1, 2, 4)[(h & 0x03) - 1]
+            if i + n > size:
+                break
+            if (h & 0x04) == 0:
+                yield h >> 3, int.from_bytes(data[i:i + n], "little")
+            i += n
+            continue
+        if (h & 0x80) != 0:                        # timestamp, extension with payload
+            while i < size and (data[i] & 0x80) != 0:
+                i += 1
+            i += 1
+
+
+def decode_itm(data, base):
+    last = {}
+    for port, val in itm_packets(data):
+        if base < port <= base + 3:
+            last[port] = val
+            continue
+        if port != base:
+            continue
+        if len(last) != 3:
+            print("incomplete event 0x%04X" % val)
+        else:
+            fnc, ev = val & 0xFF, (val >> 8) & 0xFF
+            p1, p2, cyc = last[base + 1], last[base + 2], last[base + 3]
+            if ev == 1:
+                print("%10u  %-12s begin adr 0x%08X size %u" % (cyc, fnc_name(fnc), p1, p2))
+            elif ev == 2:
+                print("%10u  %-12s end   %s, %u cycles" %
+                      (cyc, fnc_name(fnc), "Failed" if p1 else "OK", p2))
+            else:
+                print("%10u  unknown event 0x%04X" % (cyc, val))
+        last = {}
+
+
+def main(argv):
+    if len(argv) < 3 or argv[1] not in ("block", "itm"):
+        sys.exit(__doc__ or "usage: FlashTelemetry.py block|itm <file> [port]")
+    with open(argv[2], "rb") as f:
+        data = f.read()
+    if argv[1] == "block":
+        decode_block(data)
+    else:
+        decode_itm(data, int(argv[3], 0) if len(argv) > 3 else 8)
+
+
+if __name__ == "__main__":
+    main(sys.argv)
@@ -50,6 +50,25 @@
   * @{
   */
 
+/** @defgroup MX25LM51245G_Private_Constants MX25LM51245G Private Constants
+  * @{
+  */
+#define MX25LM51245G_SFDP_SIGNATURE               0x50444653U          /* "SFDP"                        */
+#define MX25LM51245G_SFDP_BFPT_ID                 0xFF00U              /* Basic Flash Parameter Table   */
+#define MX25LM51245G_SFDP_PROFILE1_ID             0xFF05U              /* xSPI Profile 1.0 Table        */
+/**
+  * @}
+  */
+
+/** @defgroup MX25LM51245G_Private_Functions MX25LM51245G Private Functions
+  * @{
+  */
+static uint32_t MX25LM51245G_SfdpDword(const uint8_t *pTable, uint32_t Number);
+static uint32_t MX25LM51245G_EraseMaxTime(uint32_t Size);
+/**
+  * @}
+  */
+
 /** @defgroup MX25LM51245G_Exported_Functions MX25LM51245G Exported Functions
   * @{
   */
@@ -75,6 +94,155 @@ int32_t MX25LM51245G_GetFlashInfo(MX25LM51245G_Info_t *pInfo)
   return MX25LM51245G_OK;
 };
 
+/**
+  * @brief  Parse the SFDP (JESD216) Basic Flash Parameter Table (density,
+  *         erase types, page size) and the xSPI Profile 1.0 Table (octal DTR
+  *         read)
+  * @param  pSfdp SFDP data read from SFDP address 0
+  * @param  Size  Number of SFDP bytes, tables beyond are ignored
+  * @param  pInfo SFDP information, compiled-in values where no parameter is found
+  * @note   No OSPI access: the function can also be run on SFDP dumps on a host
+  * @retval MX25LM51245G_OK if the Basic Flash Parameter Table was found
+  */
+int32_t MX25LM51245G_ParseSFDP(const uint8_t *pSfdp, uint32_t Size, MX25LM51245G_SFDP_t *pInfo)
+{
+  static const uint32_t read_freq[MX25LM51245G_SFDP_FREQ_NUM] = { 100U, 133U, 166U, 200U };  /* MHz */
+  static const uint32_t erase_unit[4] = { 1U, 16U, 128U, 1000U };                          /* ms  */
+  const uint8_t *hdr;
+  uint32_t bfpt = 0U, bfpt_len = 0U;
+  uint32_t prof = 0U, prof_len = 0U;
+  uint32_t nph, id, ptr, len;
+  uint32_t dw, t, ext, i;
+
+  /* Compiled-in values */
+  pInfo->FlashSize     = MX25LM51245G_FLASH_SIZE;
+  pInfo->PageSize      = MX25LM51245G_PAGE_SIZE;
+  pInfo->ReadCmd       = MX25LM51245G_OCTA_READ_DTR_CMD;
+  for (i = 0U; i < MX25LM51245G_SFDP_FREQ_NUM; i++)
+  {
+    pInfo->ReadDummyCycles[i] = 0U;
+  }
+  pInfo->MaxFreq       = 0U;
+  pInfo->EraseSize[0]  = MX25LM51245G_SUBSECTOR_4K;
+  pInfo->EraseCmd[0]   = MX25LM51245G_SUBSECTOR_ERASE_4K_CMD;
+  pInfo->EraseSize[1]  = MX25LM51245G_SECTOR_64K;
+  pInfo->EraseCmd[1]   = MX25LM51245G_SECTOR_ERASE_64K_CMD;
+  for (i = 2U; i < MX25LM51245G_SFDP_ERASE_NUM; i++)
+  {
+    pInfo->EraseSize[i] = 0U;
+    pInfo->EraseCmd[i]  = 0U;
+  }
+  for (i = 0U; i < MX25LM51245G_SFDP_ERASE_NUM; i++)
+  {
+    pInfo->EraseMaxTime[i] = MX25LM51245G_EraseMaxTime(pInfo->EraseSize[i]);
+  }
+
+  /* SFDP header: signature, revision, number of parameter headers - 1 */
+  if ((Size < 16U) || (MX25LM51245G_SfdpDword(pSfdp, 1U) != MX25LM51245G_SFDP_SIGNATURE))
+  {
+    return MX25LM51245G_ERROR;
+  }
+  nph = (uint32_t)pSfdp[6] + 1U;
+
+  /* Parameter headers: ID LSB, revision, length in DWORDs, table pointer, ID MSB */
+  for (i = 0U; (i < nph) && ((16U + (8U * i)) <= Size); i++)
+  {
+    hdr = &pSfdp[8U + (8U * i)];
+    id  = ((uint32_t)hdr[7] << 8) | hdr[0];
+    len = (uint32_t)hdr[3] * 4U;
+    ptr = ((uint32_t)hdr[6] << 16) | ((uint32_t)hdr[5] << 8) | hdr[4];
+    if ((ptr > Size) || (len > (Size - ptr)))
+    {
+      continue;                         /* table not within the data read */
+    }
+    if ((id == MX25LM51245G_SFDP_BFPT_ID) && (len > bfpt_len))
+    {
+      bfpt     = ptr;                   /* latest revision is the longest */
+      bfpt_len = len;
+    }
+    else if ((id == MX25LM51245G_SFDP_PROFILE1_ID) && (len > prof_len))
+    {
+      prof     = ptr;
+      prof_len = len;
+    }
+  }
+
+  /* JESD216 (9 DWORDs): density */
+  if (bfpt_len < (9U * 4U))
+  {
+    return MX25LM51245G_ERROR;
+  }
+
+  dw = MX25LM51245G_SfdpDword(&pSfdp[bfpt], 2U);
+  if ((dw & 0x80000000U) == 0U)
+  {
+    pInfo->FlashSize = (dw + 1U) / 8U;                     /* density - 1 in bits */
+  }
+  else if (((dw & 0x7FFFFFFFU) >= 3U) && ((dw & 0x7FFFFFFFU) <= 34U))
+  {
+    pInfo->FlashSize = 1UL << ((dw & 0x7FFFFFFFU) - 3U);   /* 2^N bits */
+  }
+
+  /* Erase types 1 to 4: size 2^N bytes (0: not supported) and command */
+  for (i = 0U; i < MX25LM51245G_SFDP_ERASE_NUM; i++)
+  {
+    dw = MX25LM51245G_SfdpDword(&pSfdp[bfpt], 8U + (i / 2U)) >> ((i & 1U) * 16U);
+    t  = dw & 0xFFU;
+    pInfo->EraseSize[i]    = ((t != 0U) && (t < 32U)) ? (1UL << t) : 0U;
+    pInfo->EraseCmd[i]     = (pInfo->EraseSize[i] != 0U) ? ((dw >> 8) & 0xFFU) : 0U;
+    pInfo->EraseMaxTime[i] = MX25LM51245G_EraseMaxTime(pInfo->EraseSize[i]);
+  }
+
+  /* JESD216A (16 DWORDs): erase times and page size */
+  if (bfpt_len >= (11U * 4U))
+  {
+    /* Typical time (count + 1) * unit, maximum 2 * (multiplier + 1) * typical */
+    dw = MX25LM51245G_SfdpDword(&pSfdp[bfpt], 10U);
+    for (i = 0U; i < MX25LM51245G_SFDP_ERASE_NUM; i++)
+    {
+      if (pInfo->EraseSize[i] != 0U)
+      {
+        t   = dw >> (4U + (7U * i));
+        ext = (t >> 5) & 0x03U;
+        pInfo->EraseMaxTime[i] = ((t & 0x1FU) + 1U) * erase_unit[ext] * 2U * ((dw & 0x0FU) + 1U);
+      }
+    }
+
+    dw = MX25LM51245G_SfdpDword(&pSfdp[bfpt], 11U);
+    pInfo->PageSize = 1UL << ((dw >> 4) & 0x0FU);
+  }
+
+  /* JESD216C (20 DWORDs): octal DTR command extension and xSPI Profile 1.0 */
+  if ((bfpt_len >= (18U * 4U)) && (prof_len >= (5U * 4U)))
+  {
+    ext = (MX25LM51245G_SfdpDword(&pSfdp[bfpt], 18U) >> 29) & 0x03U;
+    t   = (MX25LM51245G_SfdpDword(&pSfdp[prof], 1U) >> 8) & 0xFFU;
+    if ((t != 0U) && (ext <= 1U))
+    {
+      /* Extension: 0 - same as command, 1 - inverted command */
+      pInfo->ReadCmd = (t << 8) | ((ext == 0U) ? t : (~t & 0xFFU));
+
+      dw = MX25LM51245G_SfdpDword(&pSfdp[prof], 5U);
+      pInfo->ReadDummyCycles[0] = (dw >>  7) & 0x1FU;
+      pInfo->ReadDummyCycles[1] = (dw >> 17) & 0x1FU;
+      pInfo->ReadDummyCycles[2] = (dw >> 27) & 0x1FU;
+      pInfo->ReadDummyCycles[3] = (MX25LM51245G_SfdpDword(&pSfdp[prof], 4U) >> 7) & 0x1FU;
+
+      for (i = 0U; i < MX25LM51245G_SFDP_FREQ_NUM; i++)
+      {
+        /* 8D-8D-8D transfers 2 bytes per clock: even number of dummy cycles */
+        pInfo->ReadDummyCycles[i] = (pInfo->ReadDummyCycles[i] + 1U) & ~1UL;
+        if (pInfo->ReadDummyCycles[i] != 0U)
+        {
+          pInfo->MaxFreq = read_freq[i];
+        }
+      }
+    }
+  }
+
+  return MX25LM51245G_OK;
+}
+
 /**
   * @brief  Polling WIP(Write In Progress) bit become to 0
   *         SPI/OPI;
@@ -196,10 +364,11 @@ int32_t MX25LM51245G_ReadSTR(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t M
   * @param  pData Pointer to data to be read
   * @param  ReadAddr Read start addressS
   * @param  Size Size of data to read
+  * @param  DummyCycles Dummy cycles (as configured in CR2, DUMMY_CYCLES_READ_OCTAL_DTR by default)
   * @note   Only OPI mode support DTR transfer rate
   * @retval OSPI memory status
   */
-int32_t MX25LM51245G_ReadDTR(OSPI_HandleTypeDef *Ctx, uint8_t *pData, uint32_t ReadAddr, uint32_t Size)
+int32_t MX25LM51245G_ReadDTR(OSPI_HandleTypeDef *Ctx, uint8_t *pData, uint32_t ReadAddr, uint32_t Size, uint32_t DummyCycles)
 {
   OSPI_RegularCmdTypeDef s_command = {0};
 
@@ -217,7 +386,7 @@ int32_t MX25LM51245G_ReadDTR(OSPI_HandleTypeDef *Ctx, uint8_t *pData, uint32_t R
   s_command.AlternateBytesMode = HAL_OSPI_ALTERNATE_BYTES_NONE;
   s_command.DataMode           = HAL_OSPI_DATA_8_LINES;
   s_command.DataDtrMode        = HAL_OSPI_DATA_DTR_ENABLE;
-  s_command.DummyCycles        = DUMMY_CYCLES_READ_OCTAL_DTR;
+  s_command.DummyCycles        = DummyCycles;
   s_command.NbData             = Size;
   s_command.DQSMode            = HAL_OSPI_DQS_ENABLE;
   s_command.SIOOMode           = HAL_OSPI_SIOO_INST_EVERY_CMD;
@@ -466,9 +635,10 @@ int32_t MX25LM51245G_ChipErase(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t
   * @param  Ctx Component object pointer
   * @param  Mode Interface mode
   * @param  AddressSize Address size
+  * @param  Cfg Memory-mapped configuration (DQSMode not used)
   * @retval OSPI memory status
   */
-int32_t MX25LM51245G_EnableMemoryMappedModeSTR(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_AddressSize_t AddressSize)
+int32_t MX25LM51245G_EnableMemoryMappedModeSTR(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_AddressSize_t AddressSize, MX25LM51245G_MemoryMapped_t *Cfg)
 {
   OSPI_RegularCmdTypeDef      s_command = {0};
   OSPI_MemoryMappedTypeDef s_mem_mapped_cfg = {0};
@@ -494,7 +664,7 @@ int32_t MX25LM51245G_EnableMemoryMappedModeSTR(OSPI_HandleTypeDef *Ctx, MX25LM51
   s_command.DataDtrMode        = HAL_OSPI_DATA_DTR_DISABLE;
   s_command.DummyCycles        = (Mode == MX25LM51245G_SPI_MODE) ? DUMMY_CYCLES_READ : DUMMY_CYCLES_READ_OCTAL;
   s_command.DQSMode            = HAL_OSPI_DQS_DISABLE;
-  s_command.SIOOMode           = HAL_OSPI_SIOO_INST_EVERY_CMD;
+  s_command.SIOOMode           = Cfg->SIOOMode;
 
   /* Send the read command */
   if (HAL_OSPI_Command(Ctx, &s_command, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
@@ -514,7 +684,8 @@ int32_t MX25LM51245G_EnableMemoryMappedModeSTR(OSPI_HandleTypeDef *Ctx, MX25LM51
   }
 
   /* Configure the memory mapped mode */
-  s_mem_mapped_cfg.TimeOutActivation = HAL_OSPI_TIMEOUT_COUNTER_DISABLE;
+  s_mem_mapped_cfg.TimeOutActivation = Cfg->TimeOutActivation;
+  s_mem_mapped_cfg.TimeOutPeriod     = Cfg->TimeOutPeriod;
 
   if (HAL_OSPI_MemoryMapped(Ctx, &s_mem_mapped_cfg) != HAL_OK)
   {
@@ -528,11 +699,12 @@ int32_t MX25LM51245G_EnableMemoryMappedModeSTR(OSPI_HandleTypeDef *Ctx, MX25LM51
   * @brief  Enable memory mapped mode for the OSPI memory on DTR mode.
   * @param  Ctx Component object pointer
   * @param  Mode Interface mode
-  * @param  AddressSize Address size
+  * @param  Cfg Memory-mapped configuration
+  * @param  DummyCycles Dummy cycles (as configured in CR2, DUMMY_CYCLES_READ_OCTAL_DTR by default)
   * @note   Only OPI mode support DTR transfer rate
   * @retval OSPI memory status
   */
-int32_t MX25LM51245G_EnableMemoryMappedModeDTR(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode)
+int32_t MX25LM51245G_EnableMemoryMappedModeDTR(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_MemoryMapped_t *Cfg, uint32_t DummyCycles)
 {
   /* Prevent unused argument(s) compilation warning */
   UNUSED(Mode);
@@ -553,9 +725,9 @@ int32_t MX25LM51245G_EnableMemoryMappedModeDTR(OSPI_HandleTypeDef *Ctx, MX25LM51
   s_command.AlternateBytesMode = HAL_OSPI_ALTERNATE_BYTES_NONE;
   s_command.DataMode           = HAL_OSPI_DATA_8_LINES;
   s_command.DataDtrMode        = HAL_OSPI_DATA_DTR_ENABLE;
-  s_command.DummyCycles        = DUMMY_CYCLES_READ_OCTAL_DTR;
-  s_command.DQSMode            = HAL_OSPI_DQS_ENABLE;
-  s_command.SIOOMode           = HAL_OSPI_SIOO_INST_EVERY_CMD;
+  s_command.DummyCycles        = DummyCycles;
+  s_command.DQSMode            = Cfg->DQSMode;
+  s_command.SIOOMode           = Cfg->SIOOMode;
 
   /* Send the command */
   if (HAL_OSPI_Command(Ctx, &s_command, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
@@ -575,7 +747,8 @@ int32_t MX25LM51245G_EnableMemoryMappedModeDTR(OSPI_HandleTypeDef *Ctx, MX25LM51
     return MX25LM51245G_ERROR;
   }
   /* Configure the memory mapped mode */
-  s_mem_mapped_cfg.TimeOutActivation = HAL_OSPI_TIMEOUT_COUNTER_DISABLE;
+  s_mem_mapped_cfg.TimeOutActivation = Cfg->TimeOutActivation;
+  s_mem_mapped_cfg.TimeOutPeriod     = Cfg->TimeOutPeriod;
 
   if (HAL_OSPI_MemoryMapped(Ctx, &s_mem_mapped_cfg) != HAL_OK)
   {
@@ -1275,6 +1448,61 @@ int32_t MX25LM51245G_ReadID(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mo
   return MX25LM51245G_OK;
 }
 
+/**
+  * @brief  Read Serial Flash Discoverable Parameters (JESD216).
+  *         SPI/OPI; 1-1-1/8-8-8
+  * @param  Ctx Component object pointer
+  * @param  Mode Interface mode
+  * @param  Rate Transfer rate STR or DTR
+  * @param  pData Pointer to data to be read
+  * @param  ReadAddr SFDP address
+  * @param  Size Size of data to read
+  * @retval error status
+  */
+int32_t MX25LM51245G_ReadSFDP(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate, uint8_t *pData, uint32_t ReadAddr, uint32_t Size)
+{
+  OSPI_RegularCmdTypeDef s_command = {0};
+
+  /* SPI mode and DTR transfer not supported by memory */
+  if ((Mode == MX25LM51245G_SPI_MODE) && (Rate == MX25LM51245G_DTR_TRANSFER))
+  {
+    return MX25LM51245G_ERROR;
+  }
+
+  /* Initialize the read SFDP command */
+  s_command.OperationType      = HAL_OSPI_OPTYPE_COMMON_CFG;
+  s_command.FlashId            = HAL_OSPI_FLASH_ID_1;
+  s_command.InstructionMode    = (Mode == MX25LM51245G_SPI_MODE) ? HAL_OSPI_INSTRUCTION_1_LINE : HAL_OSPI_INSTRUCTION_8_LINES;
+  s_command.InstructionDtrMode = (Rate == MX25LM51245G_DTR_TRANSFER) ? HAL_OSPI_INSTRUCTION_DTR_ENABLE : HAL_OSPI_INSTRUCTION_DTR_DISABLE;
+  s_command.InstructionSize    = (Mode == MX25LM51245G_SPI_MODE) ? HAL_OSPI_INSTRUCTION_8_BITS : HAL_OSPI_INSTRUCTION_16_BITS;
+  s_command.Instruction        = (Mode == MX25LM51245G_SPI_MODE) ? MX25LM51245G_READ_SERIAL_FLASH_DISCO_PARAM_CMD : MX25LM51245G_OCTA_READ_SERIAL_FLASH_DISCO_PARAM_CMD;
+  s_command.AddressMode        = (Mode == MX25LM51245G_SPI_MODE) ? HAL_OSPI_ADDRESS_1_LINE : HAL_OSPI_ADDRESS_8_LINES;
+  s_command.AddressDtrMode     = (Rate == MX25LM51245G_DTR_TRANSFER) ? HAL_OSPI_ADDRESS_DTR_ENABLE : HAL_OSPI_ADDRESS_DTR_DISABLE;
+  s_command.AddressSize        = (Mode == MX25LM51245G_SPI_MODE) ? HAL_OSPI_ADDRESS_24_BITS : HAL_OSPI_ADDRESS_32_BITS;
+  s_command.Address            = ReadAddr;
+  s_command.AlternateBytesMode = HAL_OSPI_ALTERNATE_BYTES_NONE;
+  s_command.DataMode           = (Mode == MX25LM51245G_SPI_MODE) ? HAL_OSPI_DATA_1_LINE : HAL_OSPI_DATA_8_LINES;
+  s_command.DataDtrMode        = (Rate == MX25LM51245G_DTR_TRANSFER) ? HAL_OSPI_DATA_DTR_ENABLE : HAL_OSPI_DATA_DTR_DISABLE;
+  s_command.DummyCycles        = (Mode == MX25LM51245G_SPI_MODE) ? DUMMY_CYCLES_READ_SFDP : DUMMY_CYCLES_READ_SFDP_OCTAL;
+  s_command.NbData             = Size;
+  s_command.DQSMode            = (Rate == MX25LM51245G_DTR_TRANSFER) ? HAL_OSPI_DQS_ENABLE : HAL_OSPI_DQS_DISABLE;
+  s_command.SIOOMode           = HAL_OSPI_SIOO_INST_EVERY_CMD;
+
+  /* Configure the command */
+  if (HAL_OSPI_Command(Ctx, &s_command, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+  {
+    return MX25LM51245G_ERROR;
+  }
+
+  /* Reception of the data */
+  if (HAL_OSPI_Receive(Ctx, pData, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+  {
+    return MX25LM51245G_ERROR;
+  }
+
+  return MX25LM51245G_OK;
+}
+
 /* Reset Commands *************************************************************/
 /**
   * @brief  Flash reset enable command
@@ -1440,6 +1668,48 @@ int32_t MX25LM51245G_EnterPowerDown(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interf
   return MX25LM51245G_OK;
 }
 
+/**
+  * @}
+  */
+
+/** @addtogroup MX25LM51245G_Private_Functions
+  * @{
+  */
+
+/**
+  * @brief  Get a DWORD of an SFDP table (little endian)
+  * @param  pTable Table start
+  * @param  Number DWORD number (1 is the first DWORD)
+  * @retval DWORD value
+  */
+static uint32_t MX25LM51245G_SfdpDword(const uint8_t *pTable, uint32_t Number)
+{
+  const uint8_t *p = &pTable[4U * (Number - 1U)];
+
+  return ((uint32_t)p[3] << 24) | ((uint32_t)p[2] << 16) | ((uint32_t)p[1] << 8) | p[0];
+}
+
+/**
+  * @brief  Get the compiled-in maximum erase time of an erase size
+  * @param  Size Erase size in bytes
+  * @retval Maximum erase time in ms, 0 if the size is not known
+  */
+static uint32_t MX25LM51245G_EraseMaxTime(uint32_t Size)
+{
+  uint32_t time = 0U;
+
+  if (Size == MX25LM51245G_SUBSECTOR_4K)
+  {
+    time = MX25LM51245G_SUBSECTOR_4K_ERASE_MAX_TIME;
+  }
+  else if (Size == MX25LM51245G_SECTOR_64K)
+  {
+    time = MX25LM51245G_SECTOR_ERASE_MAX_TIME;
+  }
+
+  return time;
+}
+
 /**
   * @}
   */
@@ -66,6 +66,13 @@
 
 #define MX25LM51245G_AUTOPOLLING_INTERVAL_TIME    0x10U
 
+/**
+  * @brief  MX25LM51245G SFDP (JESD216) configuration
+  */
+#define MX25LM51245G_SFDP_SIZE                    0x200U               /* SFDP bytes read for the parameter tables      */
+#define MX25LM51245G_SFDP_FREQ_NUM                4U                   /* Octal DTR read at 100, 133, 166 and 200 MHz   */
+#define MX25LM51245G_SFDP_ERASE_NUM               4U                   /* Erase types 1 to 4 of the BFPT                */
+
 /**
   * @brief  MX25LM51245G Error codes
   */
@@ -226,6 +233,7 @@
 #define MX25LM51245G_CR2_DC_10_CYCLES                     0x05U        /*!< 10 Dummy cycles                                    */
 #define MX25LM51245G_CR2_DC_8_CYCLES                      0x06U        /*!< 8 Dummy cycles                                     */
 #define MX25LM51245G_CR2_DC_6_CYCLES                      0x07U        /*!< 6 Dummy cycles                                     */
+#define MX25LM51245G_CR2_DC_CYCLES(n)                     (uint8_t)((20U - (n)) / 2U) /*!< Dummy cycle value for n = 6..20 (even)   */
 /* Address : 0x00000500 */
 #define MX25LM51245G_CR2_REG4_ADDR                        0x00000500U  /*!< CR2 register address 0x00000500                    */
 #define MX25LM51245G_CR2_PPTSEL                           0x01U        /*!< Preamble pattern selection                         */
@@ -306,6 +314,25 @@ typedef enum {
   MX25LM51245G_4BYTES_SIZE                   /*!< 4 Bytes address mode                           */
 } MX25LM51245G_AddressSize_t;
 
+typedef struct {
+  uint32_t SIOOMode;                        /*!< HAL_OSPI_SIOO_INST_EVERY_CMD or _ONLY_FIRST_CMD */
+  uint32_t DQSMode;                         /*!< HAL_OSPI_DQS_ENABLE or _DISABLE (DTR read)      */
+  uint32_t TimeOutActivation;               /*!< HAL_OSPI_TIMEOUT_COUNTER_ENABLE or _DISABLE     */
+  uint32_t TimeOutPeriod;                   /*!< Clock cycles without access before nCS release */
+} MX25LM51245G_MemoryMapped_t;
+
+typedef struct {
+  uint32_t FlashSize;                                    /*!< Size of the flash in bytes                         */
+  uint32_t PageSize;                                     /*!< Size of pages for the program operation            */
+  uint32_t ReadCmd;                                      /*!< Octal DTR read command with extension              */
+  uint32_t ReadDummyCycles[MX25LM51245G_SFDP_FREQ_NUM];  /*!< Octal DTR read dummy cycles at 100, 133, 166 and
+                                                              200 MHz (0: not supported)                        */
+  uint32_t MaxFreq;                                      /*!< Maximum octal DTR clock in MHz (0: unknown)        */
+  uint32_t EraseSize[MX25LM51245G_SFDP_ERASE_NUM];       /*!< Erase type size in bytes (0: not supported)        */
+  uint32_t EraseCmd[MX25LM51245G_SFDP_ERASE_NUM];        /*!< Erase type SPI command, 3 byte address             */
+  uint32_t EraseMaxTime[MX25LM51245G_SFDP_ERASE_NUM];    /*!< Erase type maximum time in ms (0: unknown)         */
+} MX25LM51245G_SFDP_t;
+
 /**
   * @}
   */
@@ -315,17 +342,18 @@ typedef enum {
   */
 /* Function by commands combined */
 int32_t MX25LM51245G_GetFlashInfo(MX25LM51245G_Info_t *pInfo);
+int32_t MX25LM51245G_ParseSFDP(const uint8_t *pSfdp, uint32_t Size, MX25LM51245G_SFDP_t *pInfo);
 int32_t MX25LM51245G_AutoPollingMemReady(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate);
 
 /* Read/Write Array Commands **************************************************/
 int32_t MX25LM51245G_ReadSTR(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_AddressSize_t AddressSize, uint8_t *pData, uint32_t ReadAddr, uint32_t Size);
-int32_t MX25LM51245G_ReadDTR(OSPI_HandleTypeDef *Ctx, uint8_t *pData, uint32_t ReadAddr, uint32_t Size);
+int32_t MX25LM51245G_ReadDTR(OSPI_HandleTypeDef *Ctx, uint8_t *pData, uint32_t ReadAddr, uint32_t Size, uint32_t DummyCycles);
 int32_t MX25LM51245G_PageProgram(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_AddressSize_t AddressSize, uint8_t *pData, uint32_t WriteAddr, uint32_t Size);
 int32_t MX25LM51245G_PageProgramDTR(OSPI_HandleTypeDef *Ctx, uint8_t *pData, uint32_t WriteAddr, uint32_t Size);
 int32_t MX25LM51245G_BlockErase(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate, MX25LM51245G_AddressSize_t AddressSize, uint32_t BlockAddress, MX25LM51245G_Erase_t BlockSize);
 int32_t MX25LM51245G_ChipErase(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate);
-int32_t MX25LM51245G_EnableMemoryMappedModeSTR(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_AddressSize_t AddressSize);
-int32_t MX25LM51245G_EnableMemoryMappedModeDTR(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode);
+int32_t MX25LM51245G_EnableMemoryMappedModeSTR(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_AddressSize_t AddressSize, MX25LM51245G_MemoryMapped_t *Cfg);
+int32_t MX25LM51245G_EnableMemoryMappedModeDTR(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_MemoryMapped_t *Cfg, uint32_t DummyCycles);
 int32_t MX25LM51245G_Suspend(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate);
 int32_t MX25LM51245G_Resume(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate);
 
@@ -343,6 +371,7 @@ int32_t MX25LM51245G_ReadSecurityRegister(OSPI_HandleTypeDef *Ctx, MX25LM51245G_
 
 /* ID/Security Commands *******************************************************/
 int32_t MX25LM51245G_ReadID(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate, uint8_t *ID);
+int32_t MX25LM51245G_ReadSFDP(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate, uint8_t *pData, uint32_t ReadAddr, uint32_t Size);
 
 /* Reset Commands *************************************************************/
 int32_t MX25LM51245G_ResetEnable(OSPI_HandleTypeDef *Ctx, MX25LM51245G_Interface_t Mode, MX25LM51245G_Transfer_t Rate);
@@ -40,6 +40,8 @@
 #define DUMMY_CYCLES_READ_OCTAL_DTR  6U
 #define DUMMY_CYCLES_REG_OCTAL       4U
 #define DUMMY_CYCLES_REG_OCTAL_DTR   5U
+#define DUMMY_CYCLES_READ_SFDP       8U
+#define DUMMY_CYCLES_READ_SFDP_OCTAL 20U
 
 /**
   * @}
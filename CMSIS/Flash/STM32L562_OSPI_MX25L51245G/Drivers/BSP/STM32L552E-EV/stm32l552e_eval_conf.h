@@ -106,6 +106,13 @@ extern "C" {
   * @}
   */
 
+/* Flash algorithm telemetry: timestamps of the OSPI NOR Init phases */
+#if defined FLASH_TELEMETRY
+#include "..\..\..\..\FlashTelemetry.h"
+#define BSP_OSPI_NOR_INIT_PHASE(phase)         FLASH_TLM_PHASE(phase)
+#define BSP_OSPI_NOR_INIT_STEP(expr, phase)    FLASH_TLM_STEP(expr, phase)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
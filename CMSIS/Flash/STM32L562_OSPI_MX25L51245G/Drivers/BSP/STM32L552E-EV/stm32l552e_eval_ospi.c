@@ -131,6 +131,15 @@ OSPI_RAM_Ctx_t Ospi_Ram_Ctx[OSPI_RAM_INSTANCES_NUMBER] = {{OSPI_ACCESS_NONE,
   * @}
   */
 
+/* Private macros ------------------------------------------------------------*/
+/* Hooks for timing of the NOR Init phases, can be defined in the board conf file */
+#ifndef BSP_OSPI_NOR_INIT_PHASE
+#define BSP_OSPI_NOR_INIT_PHASE(phase)
+#endif
+#ifndef BSP_OSPI_NOR_INIT_STEP
+#define BSP_OSPI_NOR_INIT_STEP(expr, phase)    (expr)
+#endif
+
 /* Private constants --------------------------------------------------------*/
 /* Private variables ---------------------------------------------------------*/
 /** @defgroup STM32L552E-EV_OSPI_NOR_Private_Variables STM32L552E-EV OSPI_NOR Private Variables
@@ -139,6 +148,7 @@ OSPI_RAM_Ctx_t Ospi_Ram_Ctx[OSPI_RAM_INSTANCES_NUMBER] = {{OSPI_ACCESS_NONE,
 #if (USE_HAL_OSPI_REGISTER_CALLBACKS == 1)
 static uint32_t OspiNor_IsMspCbValid[OSPI_NOR_INSTANCES_NUMBER] = {0};
 #endif /* USE_HAL_OSPI_REGISTER_CALLBACKS */
+static uint8_t  OspiNor_Sfdp[MX25LM51245G_SFDP_SIZE];
 /**
   * @}
   */
@@ -164,6 +174,8 @@ static int32_t OSPI_NOR_ResetMemory  (uint32_t Instance);
 static int32_t OSPI_NOR_EnterDOPIMode(uint32_t Instance);
 static int32_t OSPI_NOR_EnterSOPIMode(uint32_t Instance);
 static int32_t OSPI_NOR_ExitOPIMode  (uint32_t Instance);
+static void    OSPI_NOR_ReadSFDP     (uint32_t Instance);
+static void    OSPI_NOR_CacheRemap   (uint32_t Instance, uint32_t Enable);
 /**
   * @}
   */
@@ -219,39 +231,54 @@ int32_t BSP_OSPI_NOR_Init(uint32_t Instance, BSP_OSPI_NOR_Init_t *Init)
         }
       }
 #endif /* USE_HAL_OSPI_REGISTER_CALLBACKS */
+      BSP_OSPI_NOR_INIT_PHASE(FLASH_TLM_PH_MSP);
 
       /* Get Flash informations of one memory */
       (void)MX25LM51245G_GetFlashInfo(&pInfo);
 
+      /* Default memory-mapped configuration */
+      Ospi_Nor_Ctx[Instance].MemoryMapped.Ospi.SIOOMode          = HAL_OSPI_SIOO_INST_EVERY_CMD;
+      Ospi_Nor_Ctx[Instance].MemoryMapped.Ospi.DQSMode           = HAL_OSPI_DQS_ENABLE;
+      Ospi_Nor_Ctx[Instance].MemoryMapped.Ospi.TimeOutActivation = HAL_OSPI_TIMEOUT_COUNTER_DISABLE;
+      Ospi_Nor_Ctx[Instance].MemoryMapped.Ospi.TimeOutPeriod     = 0U;
+      Ospi_Nor_Ctx[Instance].MemoryMapped.CacheRemap             = BSP_OSPI_NOR_CACHE_REMAP_NONE;
+      Ospi_Nor_Ctx[Instance].MemoryMapped.CacheBurst             = BSP_OSPI_NOR_CACHE_BURST_INCR;
+
       /* Fill config structure */
-      ospi_init.ClockPrescaler = 3; /* OctoSPI clock = 120MHz / ClockPrescaler = 40MHz */
+      ospi_init.ClockPrescaler = BSP_OSPI_NOR_CLOCK_PRESCALER; /* OctoSPI clock = 120MHz / ClockPrescaler = 40MHz */
       ospi_init.MemorySize     = (uint32_t)POSITION_VAL((uint32_t)pInfo.FlashSize);
       ospi_init.SampleShifting = HAL_OSPI_SAMPLE_SHIFTING_NONE;
       ospi_init.TransferRate   = (uint32_t) Init->TransferRate;
 
       /* STM32 OSPI interface initialization */
-      if (MX_OSPI_NOR_Init(&hospi_nor[Instance], &ospi_init) != HAL_OK)
+      if (BSP_OSPI_NOR_INIT_STEP(MX_OSPI_NOR_Init(&hospi_nor[Instance], &ospi_init), FLASH_TLM_PH_OSPI) != HAL_OK)
       {
         ret = BSP_ERROR_PERIPH_FAILURE;
       }
       /* OSPI memory reset */
-      else if (OSPI_NOR_ResetMemory(Instance) != BSP_ERROR_NONE)
+      else if (BSP_OSPI_NOR_INIT_STEP(OSPI_NOR_ResetMemory(Instance), FLASH_TLM_PH_RESET) != BSP_ERROR_NONE)
       {
         ret = BSP_ERROR_COMPONENT_FAILURE;
       }
       /* Check if memory is ready */
-      else if (MX25LM51245G_AutoPollingMemReady(&hospi_nor[Instance], Ospi_Nor_Ctx[Instance].InterfaceMode, Ospi_Nor_Ctx[Instance].TransferRate) != MX25LM51245G_OK)
-      {
-        ret = BSP_ERROR_COMPONENT_FAILURE;
-      }
-      /* Configure the memory */
-      else if (BSP_OSPI_NOR_ConfigFlash(Instance, Init->InterfaceMode, Init->TransferRate) != BSP_ERROR_NONE)
+      else if (BSP_OSPI_NOR_INIT_STEP(MX25LM51245G_AutoPollingMemReady(&hospi_nor[Instance], Ospi_Nor_Ctx[Instance].InterfaceMode, Ospi_Nor_Ctx[Instance].TransferRate), FLASH_TLM_PH_READY) != MX25LM51245G_OK)
       {
         ret = BSP_ERROR_COMPONENT_FAILURE;
       }
       else
       {
-        ret = BSP_ERROR_NONE;
+        /* Read the memory parameters (SFDP), compiled-in values if not found */
+        OSPI_NOR_ReadSFDP(Instance);
+
+        /* Configure the memory */
+        if (BSP_OSPI_NOR_INIT_STEP(BSP_OSPI_NOR_ConfigFlash(Instance, Init->InterfaceMode, Init->TransferRate), FLASH_TLM_PH_CONFIG) != BSP_ERROR_NONE)
+        {
+          ret = BSP_ERROR_COMPONENT_FAILURE;
+        }
+        else
+        {
+          ret = BSP_ERROR_NONE;
+        }
       }
     }
     else
@@ -454,7 +481,7 @@ int32_t BSP_OSPI_NOR_Read(uint32_t Instance, uint8_t* pData, uint32_t ReadAddr,
     }
     else
     {
-      if(MX25LM51245G_ReadDTR(&hospi_nor[Instance], pData, ReadAddr, Size) != MX25LM51245G_OK)
+      if(MX25LM51245G_ReadDTR(&hospi_nor[Instance], pData, ReadAddr, Size, Ospi_Nor_Ctx[Instance].DummyCycles) != MX25LM51245G_OK)
       {
         ret = BSP_ERROR_COMPONENT_FAILURE;
       }
@@ -481,7 +508,7 @@ int32_t BSP_OSPI_NOR_Write(uint32_t Instance, uint8_t* pData, uint32_t WriteAddr
 {
   int32_t ret = BSP_ERROR_NONE;
   uint32_t end_addr, current_size, current_addr;
-  uint32_t data_addr;
+  uint32_t data_addr, page_size;
 
   /* Check if the instance is supported */
   if(Instance >= OSPI_NOR_INSTANCES_NUMBER)
@@ -491,7 +518,8 @@ int32_t BSP_OSPI_NOR_Write(uint32_t Instance, uint8_t* pData, uint32_t WriteAddr
   else
   {
     /* Calculation of the size between the write address and the end of the page */
-    current_size = MX25LM51245G_PAGE_SIZE - (WriteAddr % MX25LM51245G_PAGE_SIZE);
+    page_size    = Ospi_Nor_Ctx[Instance].Sfdp.PageSize;
+    current_size = page_size - (WriteAddr % page_size);
 
     /* Check if the size of the data is less than the remaining place in the page */
     if (current_size > Size)
@@ -547,7 +575,7 @@ int32_t BSP_OSPI_NOR_Write(uint32_t Instance, uint8_t* pData, uint32_t WriteAddr
             /* Update the address and size variables for next page programming */
             current_addr += current_size;
             data_addr += current_size;
-            current_size = ((current_addr + MX25LM51245G_PAGE_SIZE) > end_addr) ? (end_addr - current_addr) : MX25LM51245G_PAGE_SIZE;
+            current_size = ((current_addr + page_size) > end_addr) ? (end_addr - current_addr) : page_size;
           }
         }
       }
@@ -703,6 +731,17 @@ int32_t BSP_OSPI_NOR_GetInfo(uint32_t Instance, BSP_OSPI_NOR_Info_t* pInfo)
   else
   {
     (void)MX25LM51245G_GetFlashInfo(pInfo);
+
+    /* Size and page size read from the memory (SFDP) */
+    if (Ospi_Nor_Ctx[Instance].Sfdp.FlashSize != 0U)
+    {
+      pInfo->FlashSize             = Ospi_Nor_Ctx[Instance].Sfdp.FlashSize;
+      pInfo->EraseSectorsNumber    = pInfo->FlashSize / pInfo->EraseSectorSize;
+      pInfo->EraseSubSectorNumber  = pInfo->FlashSize / pInfo->EraseSubSectorSize;
+      pInfo->EraseSubSector1Number = pInfo->FlashSize / pInfo->EraseSubSector1Size;
+      pInfo->ProgPageSize          = Ospi_Nor_Ctx[Instance].Sfdp.PageSize;
+      pInfo->ProgPagesNumber       = pInfo->FlashSize / pInfo->ProgPageSize;
+    }
   }
 
   /* Return BSP status */
@@ -727,7 +766,7 @@ int32_t BSP_OSPI_NOR_EnableMemoryMappedMode(uint32_t Instance)
   {
     if(Ospi_Nor_Ctx[Instance].TransferRate == BSP_OSPI_NOR_STR_TRANSFER)
     {
-      if(MX25LM51245G_EnableMemoryMappedModeSTR(&hospi_nor[Instance], Ospi_Nor_Ctx[Instance].InterfaceMode, MX25LM51245G_4BYTES_SIZE) != MX25LM51245G_OK)
+      if(MX25LM51245G_EnableMemoryMappedModeSTR(&hospi_nor[Instance], Ospi_Nor_Ctx[Instance].InterfaceMode, MX25LM51245G_4BYTES_SIZE, &Ospi_Nor_Ctx[Instance].MemoryMapped.Ospi) != MX25LM51245G_OK)
       {
         ret = BSP_ERROR_COMPONENT_FAILURE;
       }
@@ -738,7 +777,7 @@ int32_t BSP_OSPI_NOR_EnableMemoryMappedMode(uint32_t Instance)
     }
     else
     {
-      if(MX25LM51245G_EnableMemoryMappedModeDTR(&hospi_nor[Instance], Ospi_Nor_Ctx[Instance].InterfaceMode) != MX25LM51245G_OK)
+      if(MX25LM51245G_EnableMemoryMappedModeDTR(&hospi_nor[Instance], Ospi_Nor_Ctx[Instance].InterfaceMode, &Ospi_Nor_Ctx[Instance].MemoryMapped.Ospi, Ospi_Nor_Ctx[Instance].DummyCycles) != MX25LM51245G_OK)
       {
         ret = BSP_ERROR_COMPONENT_FAILURE;
       }
@@ -747,6 +786,12 @@ int32_t BSP_OSPI_NOR_EnableMemoryMappedMode(uint32_t Instance)
         Ospi_Nor_Ctx[Instance].IsInitialized = OSPI_ACCESS_MMP;
       }
     }
+
+    /* Map the memory into the Code region through the ICACHE */
+    if((ret == BSP_ERROR_NONE) && (Ospi_Nor_Ctx[Instance].MemoryMapped.CacheRemap != BSP_OSPI_NOR_CACHE_REMAP_NONE))
+    {
+      OSPI_NOR_CacheRemap(Instance, 1U);
+    }
   }
 
   /* Return BSP status */
@@ -770,6 +815,13 @@ int32_t BSP_OSPI_NOR_DisableMemoryMappedMode(uint32_t Instance)
   }
   else
   {
+    /* Remove the ICACHE region before the memory leaves memory-mapped mode */
+    if((Ospi_Nor_Ctx[Instance].IsInitialized == OSPI_ACCESS_MMP) &&
+       (Ospi_Nor_Ctx[Instance].MemoryMapped.CacheRemap != BSP_OSPI_NOR_CACHE_REMAP_NONE))
+    {
+      OSPI_NOR_CacheRemap(Instance, 0U);
+    }
+
     if(Ospi_Nor_Ctx[Instance].IsInitialized != OSPI_ACCESS_MMP)
     {
       ret = BSP_ERROR_OSPI_MMP_UNLOCK_FAILURE;
@@ -788,6 +840,41 @@ int32_t BSP_OSPI_NOR_DisableMemoryMappedMode(uint32_t Instance)
   return ret;
 }
 
+/**
+  * @brief  Set the memory-mapped configuration used by BSP_OSPI_NOR_EnableMemoryMappedMode().
+  *         BSP_OSPI_NOR_Init() sets the default: instruction on every command, DQS on DTR
+  *         read, no timeout counter and no ICACHE remap.
+  * @param  Instance  OSPI instance
+  * @param  Cfg  Memory-mapped configuration
+  * @note   With SIOO the instruction is sent only with the first command; use it only
+  *         if the memory continues a read without instruction.
+  *         With CacheRemap the ICACHE region 0 maps the memory into the Code region;
+  *         the ICACHE is enabled and invalidated on every change of the region, and
+  *         gets its previous enable state back when the region is removed.
+  * @retval BSP status
+  */
+int32_t BSP_OSPI_NOR_ConfigMemoryMappedMode(uint32_t Instance, BSP_OSPI_NOR_MemoryMapped_t *Cfg)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  /* Check if the instance is supported */
+  if(Instance >= OSPI_NOR_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if(Ospi_Nor_Ctx[Instance].IsInitialized == OSPI_ACCESS_MMP)
+  {
+    ret = BSP_ERROR_BUSY;
+  }
+  else
+  {
+    Ospi_Nor_Ctx[Instance].MemoryMapped = *Cfg;
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
 /**
   * @brief  Get flash ID 3 Bytes:
   *         Manufacturer ID, Memory type, Memory density
@@ -1038,6 +1125,52 @@ int32_t BSP_OSPI_NOR_LeaveDeepPowerDown(uint32_t Instance)
   /* Return BSP status */
   return ret;
 }
+
+/**
+  * @brief  Configures OCTOSPI1 for the NOR memory again after HyperRAM accesses.
+  *         NOR memory and HyperRAM share OCTOSPI1. Both are initialized once,
+  *         this function only restores the OCTOSPI1 configuration: the memory
+  *         is neither reset nor configured, it stays in its interface mode.
+  * @param  Instance  OSPI instance
+  * @retval BSP status
+  */
+int32_t BSP_OSPI_NOR_Select(uint32_t Instance)
+{
+  int32_t ret = BSP_ERROR_NONE;
+
+  /* Check if the instance is supported */
+  if(Instance >= OSPI_NOR_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if(Ospi_Nor_Ctx[Instance].IsInitialized == OSPI_ACCESS_NONE)
+  {
+    ret = BSP_ERROR_NO_INIT;
+  }
+  else
+  {
+    /* Release OCTOSPI1 from HyperRAM memory-mapped mode */
+    if(Ospi_Ram_Ctx[0].IsInitialized == OSPI_ACCESS_MMP)
+    {
+      ret = BSP_OSPI_RAM_DisableMemoryMappedMode(0);
+    }
+
+    if(ret == BSP_ERROR_NONE)
+    {
+      /* Disable OCTOSPI1, HAL_OSPI_Init applies the NOR configuration */
+      (void)HAL_OSPI_DeInit(&hospi_nor[Instance]);
+
+      if(HAL_OSPI_Init(&hospi_nor[Instance]) != HAL_OK)
+      {
+        ret = BSP_ERROR_PERIPH_FAILURE;
+      }
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
 /**
   * @}
   */
@@ -1691,6 +1824,65 @@ int32_t BSP_OSPI_RAM_LeaveDeepPowerDown(uint32_t Instance)
   return ret;
 }
 
+/**
+  * @brief  Configures OCTOSPI1 for the HyperRAM again after NOR memory accesses.
+  *         NOR memory and HyperRAM share OCTOSPI1. Both are initialized once,
+  *         this function only restores the OCTOSPI1 configuration and the
+  *         HyperBus latency set by BSP_OSPI_RAM_ConfigHyperRAM.
+  * @param  Instance  OSPI instance
+  * @retval BSP status
+  */
+int32_t BSP_OSPI_RAM_Select(uint32_t Instance)
+{
+  int32_t ret = BSP_ERROR_NONE;
+  OSPI_HyperbusCfgTypeDef sHyperbusCfg;
+
+  /* Check if the instance is supported */
+  if(Instance >= OSPI_RAM_INSTANCES_NUMBER)
+  {
+    ret = BSP_ERROR_WRONG_PARAM;
+  }
+  else if(Ospi_Ram_Ctx[Instance].IsInitialized == OSPI_ACCESS_NONE)
+  {
+    ret = BSP_ERROR_NO_INIT;
+  }
+  else
+  {
+    /* Release OCTOSPI1 from NOR memory-mapped mode */
+    if(Ospi_Nor_Ctx[0].IsInitialized == OSPI_ACCESS_MMP)
+    {
+      ret = BSP_OSPI_NOR_DisableMemoryMappedMode(0);
+    }
+
+    if(ret == BSP_ERROR_NONE)
+    {
+      /* Disable OCTOSPI1, HAL_OSPI_Init applies the HyperRAM configuration */
+      (void)HAL_OSPI_DeInit(&hospi_ram[Instance]);
+
+      if(HAL_OSPI_Init(&hospi_ram[Instance]) != HAL_OK)
+      {
+        ret = BSP_ERROR_PERIPH_FAILURE;
+      }
+      else
+      {
+        sHyperbusCfg.RWRecoveryTime   = RW_RECOVERY_TIME;
+        sHyperbusCfg.AccessTime       = (uint32_t) ((Ospi_Ram_Ctx[Instance].LatencyType == BSP_OSPI_RAM_FIXED_LATENCY) ? \
+                                         OPTIMAL_FIXED_INITIAL_LATENCY : OPTIMAL_VARIABLE_INITIAL_LATENCY);
+        sHyperbusCfg.WriteZeroLatency = HAL_OSPI_LATENCY_ON_WRITE;
+        sHyperbusCfg.LatencyMode      = (uint32_t) Ospi_Ram_Ctx[Instance].LatencyType;
+
+        if (HAL_OSPI_HyperbusCfg(&hospi_ram[Instance], &sHyperbusCfg, HAL_OSPI_TIMEOUT_DEFAULT_VALUE) != HAL_OK)
+        {
+          ret = BSP_ERROR_PERIPH_FAILURE;
+        }
+      }
+    }
+  }
+
+  /* Return BSP status */
+  return ret;
+}
+
 /**
   * @brief  Handles OctoSPI HyperRAM DMA transfer interrupt request.
   * @param  Instance OSPI instance
@@ -1914,7 +2106,7 @@ static int32_t OSPI_NOR_EnterDOPIMode(uint32_t Instance)
     ret = BSP_ERROR_COMPONENT_FAILURE;
   }
   /* Write Configuration register 2 (with new dummy cycles) */
-  else if (MX25LM51245G_WriteCfg2Register(&hospi_nor[Instance], Ospi_Nor_Ctx[Instance].InterfaceMode, Ospi_Nor_Ctx[Instance].TransferRate, MX25LM51245G_CR2_REG3_ADDR, MX25LM51245G_CR2_DC_6_CYCLES) != MX25LM51245G_OK)
+  else if (MX25LM51245G_WriteCfg2Register(&hospi_nor[Instance], Ospi_Nor_Ctx[Instance].InterfaceMode, Ospi_Nor_Ctx[Instance].TransferRate, MX25LM51245G_CR2_REG3_ADDR, MX25LM51245G_CR2_DC_CYCLES(Ospi_Nor_Ctx[Instance].DummyCycles)) != MX25LM51245G_OK)
   {
     ret = BSP_ERROR_COMPONENT_FAILURE;
   }
@@ -1933,9 +2125,11 @@ static int32_t OSPI_NOR_EnterDOPIMode(uint32_t Instance)
     /* Wait that the configuration is effective and check that memory is ready */
     HAL_Delay(MX25LM51245G_WRITE_REG_MAX_TIME);
 
-    /* Reconfigure the memory type of the peripheral */
+    /* Reconfigure the memory type, size and clock of the peripheral */
     hospi_nor[Instance].Init.MemoryType            = HAL_OSPI_MEMTYPE_MACRONIX;
     hospi_nor[Instance].Init.DelayHoldQuarterCycle = HAL_OSPI_DHQC_ENABLE;
+    hospi_nor[Instance].Init.DeviceSize            = (uint32_t)POSITION_VAL(Ospi_Nor_Ctx[Instance].Sfdp.FlashSize);
+    hospi_nor[Instance].Init.ClockPrescaler        = Ospi_Nor_Ctx[Instance].ClockPrescaler;
     if (HAL_OSPI_Init(&hospi_nor[Instance]) != HAL_OK)
     {
       ret = BSP_ERROR_PERIPH_FAILURE;
@@ -2064,9 +2258,10 @@ static int32_t OSPI_NOR_ExitOPIMode (uint32_t Instance)
 
       if (Ospi_Nor_Ctx[Instance].TransferRate == BSP_OSPI_NOR_DTR_TRANSFER)
       {
-        /* Reconfigure the memory type of the peripheral */
+        /* Reconfigure the memory type and clock of the peripheral */
         hospi_nor[Instance].Init.MemoryType            = HAL_OSPI_MEMTYPE_MICRON;
         hospi_nor[Instance].Init.DelayHoldQuarterCycle = HAL_OSPI_DHQC_DISABLE;
+        hospi_nor[Instance].Init.ClockPrescaler        = BSP_OSPI_NOR_CLOCK_PRESCALER;
         if (HAL_OSPI_Init(&hospi_nor[Instance]) != HAL_OK)
         {
           ret = BSP_ERROR_PERIPH_FAILURE;
@@ -2101,6 +2296,121 @@ static int32_t OSPI_NOR_ExitOPIMode (uint32_t Instance)
   return ret;
 }
 
+/**
+  * @brief  This function reads the SFDP parameters of the memory (SPI mode)
+  *         and selects the clock prescaler and read dummy cycles of the DTR
+  *         OPI mode. Compiled-in values are used for parameters not found,
+  *         and for all parameters if the memory has no SFDP tables.
+  * @note   Below the lowest SFDP read frequency (100 MHz) the compiled-in
+  *         dummy cycles are used if they are fewer.
+  * @param  Instance  OSPI instance
+  * @retval None
+  */
+static void OSPI_NOR_ReadSFDP(uint32_t Instance)
+{
+  static const uint32_t freq[MX25LM51245G_SFDP_FREQ_NUM] = { 100U, 133U, 166U, 200U };  /* MHz */
+  uint32_t clk, max, prescaler, dummy, i;
+
+  /* Compiled-in timing */
+  Ospi_Nor_Ctx[Instance].ClockPrescaler = BSP_OSPI_NOR_CLOCK_PRESCALER;
+  Ospi_Nor_Ctx[Instance].DummyCycles    = DUMMY_CYCLES_READ_OCTAL_DTR;
+  clk = HAL_RCCEx_GetPeriphCLKFreq(RCC_PERIPHCLK_OSPI);
+
+  if (MX25LM51245G_ReadSFDP(&hospi_nor[Instance], Ospi_Nor_Ctx[Instance].InterfaceMode, Ospi_Nor_Ctx[Instance].TransferRate, OspiNor_Sfdp, 0U, MX25LM51245G_SFDP_SIZE) != MX25LM51245G_OK)
+  {
+    (void)MX25LM51245G_ParseSFDP(OspiNor_Sfdp, 0U, &Ospi_Nor_Ctx[Instance].Sfdp);   /* compiled-in values */
+  }
+  /* Only the read command of the component can be issued, the clock is checked before the divisions */
+  else if ((MX25LM51245G_ParseSFDP(OspiNor_Sfdp, MX25LM51245G_SFDP_SIZE, &Ospi_Nor_Ctx[Instance].Sfdp) == MX25LM51245G_OK) &&
+           (Ospi_Nor_Ctx[Instance].Sfdp.MaxFreq != 0U) &&
+           (Ospi_Nor_Ctx[Instance].Sfdp.ReadCmd == MX25LM51245G_OCTA_READ_DTR_CMD) &&
+           (clk != 0U))
+  {
+    /* Fastest clock within the memory and board limits */
+    max = (Ospi_Nor_Ctx[Instance].Sfdp.MaxFreq < BSP_OSPI_NOR_DTR_MAX_FREQ) ? Ospi_Nor_Ctx[Instance].Sfdp.MaxFreq : BSP_OSPI_NOR_DTR_MAX_FREQ;
+    max = max * 1000000U;
+    prescaler = (clk + max - 1U) / max;
+
+    /* Dummy cycles of the lowest SFDP frequency not below the clock */
+    for (i = 0U; i < MX25LM51245G_SFDP_FREQ_NUM; i++)
+    {
+      if ((Ospi_Nor_Ctx[Instance].Sfdp.ReadDummyCycles[i] != 0U) && ((clk / prescaler) <= (freq[i] * 1000000U)))
+      {
+        break;
+      }
+    }
+
+    if ((prescaler <= 256U) && (i < MX25LM51245G_SFDP_FREQ_NUM))
+    {
+      /* CR2 supports 6 to 20 dummy cycles */
+      dummy = Ospi_Nor_Ctx[Instance].Sfdp.ReadDummyCycles[i];
+      if (((clk / prescaler) < (freq[0] * 1000000U)) && (DUMMY_CYCLES_READ_OCTAL_DTR >= 6U) && (DUMMY_CYCLES_READ_OCTAL_DTR < dummy))
+      {
+        dummy = DUMMY_CYCLES_READ_OCTAL_DTR;
+      }
+      if (dummy < 6U)
+      {
+        dummy = 6U;
+      }
+      if (dummy <= 20U)
+      {
+        Ospi_Nor_Ctx[Instance].ClockPrescaler = prescaler;
+        Ospi_Nor_Ctx[Instance].DummyCycles    = dummy;
+      }
+    }
+  }
+  else
+  {
+    /* Compiled-in timing */
+  }
+}
+
+/**
+  * @brief  Set or remove the ICACHE region of the memory-mapped OSPI memory.
+  * @param  Instance  OSPI instance
+  * @param  Enable  1 to map the memory at MemoryMapped.CacheRemap, 0 to remove the region
+  * @note   The ICACHE is enabled with the region; removing the region restores the
+  *         enable state the ICACHE had before.
+  * @retval None
+  */
+static void OSPI_NOR_CacheRemap(uint32_t Instance, uint32_t Enable)
+{
+  static uint32_t cache_en;
+  uint32_t cr = ICACHE->CR;
+  uint32_t rsize = 1U;
+
+  /* Region registers are written with ICACHE disabled, disabling invalidates the cache */
+  CLEAR_BIT(ICACHE->CR, ICACHE_CR_EN);
+  while(READ_BIT(ICACHE->CR, ICACHE_CR_EN) != 0U)
+  {
+  }
+
+  if(Enable != 0U)
+  {
+    /* Region size is 2^RSIZE MBytes */
+    while(((0x100000UL << rsize) < MX25LM51245G_FLASH_SIZE) && (rsize < 7U))
+    {
+      rsize++;
+    }
+
+    ICACHE->CRR0 = (((Ospi_Nor_Ctx[Instance].MemoryMapped.CacheRemap >> 21) & 0xFFUL) << ICACHE_CRRx_BASEADDR_Pos) |
+                   (rsize << ICACHE_CRRx_RSIZE_Pos)                                                        |
+                   ((OCTOSPI1_BASE >> 21) << ICACHE_CRRx_REMAPADDR_Pos)                                    |
+                   ICACHE_CRRx_MSTSEL                                                                      |
+                   Ospi_Nor_Ctx[Instance].MemoryMapped.CacheBurst                                          |
+                   ICACHE_CRRx_REN;
+    cache_en = cr & ICACHE_CR_EN;
+    cr |= ICACHE_CR_EN;
+  }
+  else
+  {
+    ICACHE->CRR0 = 0U;
+    cr = (cr & ~ICACHE_CR_EN) | cache_en;
+  }
+
+  ICACHE->CR = cr;
+}
+
 /**
   * @}
   */
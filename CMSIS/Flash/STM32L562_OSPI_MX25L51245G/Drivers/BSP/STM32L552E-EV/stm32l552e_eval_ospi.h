@@ -80,12 +80,25 @@ typedef struct
 #define BSP_OSPI_NOR_Interface_t           MX25LM51245G_Interface_t
 #define BSP_OSPI_NOR_Transfer_t            MX25LM51245G_Transfer_t
 #define BSP_OSPI_NOR_Erase_t               MX25LM51245G_Erase_t
+#define BSP_OSPI_NOR_SFDP_t                MX25LM51245G_SFDP_t
+
+typedef struct
+{
+  MX25LM51245G_MemoryMapped_t Ospi;          /*!<  SIOO, DQS and timeout counter of the read command */
+  uint32_t                   CacheRemap;     /*!<  Code region address (2 MB aligned) the ICACHE remaps
+                                                   to OCTOSPI1_BASE, or BSP_OSPI_NOR_CACHE_REMAP_NONE */
+  uint32_t                   CacheBurst;     /*!<  ICACHE burst type of the remapped region          */
+} BSP_OSPI_NOR_MemoryMapped_t;
 
 typedef struct
 {
   OSPI_Access_t              IsInitialized;  /*!<  Instance access Flash method     */
   BSP_OSPI_NOR_Interface_t   InterfaceMode;  /*!<  Flash Interface mode of Instance */
   BSP_OSPI_NOR_Transfer_t    TransferRate;   /*!<  Flash Transfer mode of Instance  */
+  BSP_OSPI_NOR_MemoryMapped_t MemoryMapped;  /*!<  Memory-mapped configuration      */
+  BSP_OSPI_NOR_SFDP_t        Sfdp;           /*!<  Memory parameters read at Init   */
+  uint32_t                   ClockPrescaler; /*!<  Clock prescaler in DTR OPI mode  */
+  uint32_t                   DummyCycles;    /*!<  Read dummy cycles in DTR OPI mode */
 } OSPI_NOR_Ctx_t;
 
 typedef struct
@@ -226,6 +239,15 @@ typedef struct
 /* OSPI block sizes */
 #define BSP_OSPI_NOR_BLOCK_4K             MX25LM51245G_SUBSECTOR_4K
 #define BSP_OSPI_NOR_BLOCK_64K            MX25LM51245G_SECTOR_64K
+
+/* OSPI NOR clock */
+#define BSP_OSPI_NOR_CLOCK_PRESCALER      3U                   /* Without SFDP timing, and in SPI and STR OPI mode */
+#define BSP_OSPI_NOR_DTR_MAX_FREQ         55U                  /* Highest DTR OPI clock of the board (MHz) */
+
+/* OSPI memory-mapped ICACHE remap */
+#define BSP_OSPI_NOR_CACHE_REMAP_NONE     0U                   /* Read at OCTOSPI1_BASE, not cached */
+#define BSP_OSPI_NOR_CACHE_BURST_WRAP     0U                   /* WRAP burst (memory must support wrap) */
+#define BSP_OSPI_NOR_CACHE_BURST_INCR     ICACHE_CRRx_HBURST   /* INCR burst */
 /**
   * @}
   */
@@ -287,12 +309,14 @@ int32_t BSP_OSPI_NOR_GetStatus                   (uint32_t Instance);
 int32_t BSP_OSPI_NOR_GetInfo                     (uint32_t Instance, BSP_OSPI_NOR_Info_t* pInfo);
 int32_t BSP_OSPI_NOR_EnableMemoryMappedMode      (uint32_t Instance);
 int32_t BSP_OSPI_NOR_DisableMemoryMappedMode     (uint32_t Instance);
+int32_t BSP_OSPI_NOR_ConfigMemoryMappedMode      (uint32_t Instance, BSP_OSPI_NOR_MemoryMapped_t *Cfg);
 int32_t BSP_OSPI_NOR_ReadID                      (uint32_t Instance, uint8_t *Id);
 int32_t BSP_OSPI_NOR_ConfigFlash                 (uint32_t Instance, BSP_OSPI_NOR_Interface_t Mode, BSP_OSPI_NOR_Transfer_t Rate);
 int32_t BSP_OSPI_NOR_SuspendErase                (uint32_t Instance);
 int32_t BSP_OSPI_NOR_ResumeErase                 (uint32_t Instance);
 int32_t BSP_OSPI_NOR_EnterDeepPowerDown          (uint32_t Instance);
 int32_t BSP_OSPI_NOR_LeaveDeepPowerDown          (uint32_t Instance);
+int32_t BSP_OSPI_NOR_Select                      (uint32_t Instance);
 
 /* These functions can be modified in case the current settings
    need to be changed for specific application needs */
@@ -320,6 +344,7 @@ int32_t BSP_OSPI_RAM_DisableMemoryMappedMode     (uint32_t Instance);
 int32_t BSP_OSPI_RAM_ConfigHyperRAM              (uint32_t Instance, BSP_OSPI_RAM_Latency_t Latency, BSP_OSPI_RAM_BurstType_t BurstType, BSP_OSPI_RAM_BurstLength_t BurstLength);
 int32_t BSP_OSPI_RAM_EnterDeepPowerDown          (uint32_t Instance);
 int32_t BSP_OSPI_RAM_LeaveDeepPowerDown          (uint32_t Instance);
+int32_t BSP_OSPI_RAM_Select                      (uint32_t Instance);
 
 void    BSP_OSPI_RAM_DMA_IRQHandler              (uint32_t Instance);
 void    BSP_OSPI_RAM_IRQHandler                  (uint32_t Instance);
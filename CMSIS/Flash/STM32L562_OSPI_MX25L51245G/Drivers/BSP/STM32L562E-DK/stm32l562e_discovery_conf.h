@@ -56,6 +56,13 @@ extern "C" {
 /* Default AUDIO IN internal buffer size in 32-bit words per micro */
 #define BSP_AUDIO_IN_DEFAULT_BUFFER_SIZE 2048UL /* 2048*4 = 8Kbytes */
 
+/* Flash algorithm telemetry: timestamps of the OSPI NOR Init phases */
+#if defined FLASH_TELEMETRY
+#include "..\..\..\..\FlashTelemetry.h"
+#define BSP_OSPI_NOR_INIT_PHASE(phase)         FLASH_TLM_PHASE(phase)
+#define BSP_OSPI_NOR_INIT_STEP(expr, phase)    FLASH_TLM_STEP(expr, phase)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,22 +18,43 @@
  * 3. This notice may not be removed or altered from any source distribution.
  *
  *
- * $Date:        25. May 2020
- * $Revision:    V1.0.0
+ * $Date:        18. October 2026
+ * $Revision:    V1.1.0
  *
  * Project:      Flash Programming Functions for
  *               ST STM32L562 (STM32L562E-DK) with OSPI MX25LM51245G (Macronix)
  * --------------------------------------------------------------------------- */
 
 /* History:
+ *  Version 1.1.0
+ *    Added asynchronous erase functions
+ *    EraseSector queues erases (erase-ahead, ERASE_AHEAD blocks),
+ *    queue depth limited by the SFDP 64K erase time,
+ *    ProgramPage suspends a running erase for pages of erased blocks
+ *    Added HyperRAM staging functions (STM32L552E-EVAL)
+ *    Added optional telemetry (FLASH_TELEMETRY)
+ *    Added Init phase timestamps to telemetry
+ *    Added optional OCTOSPI transaction recorder (OSPI_TRACE)
+ *    Added optional ITM events (FLASH_TELEMETRY_ITM)
+ *    Verify and BlankCheck compare words (FlashCompare.h)
+ *    Added Digest function (SHA-256, HASH peripheral on STM32L562)
+ *    Added lean register-level NOR driver (OSPI_NOR_LEAN, OspiNor.c)
+ *    Read functions use the faster memory-mapped configuration (ReadBench)
  *  Version 1.0.0
  *    Initial release
  */
 
 #include <string.h>
 #include "..\FlashOS.h"                /* FlashOS Structures */
+#include "..\FlashOSExt.h"             /* Asynchronous Functions, Digest */
+#include "..\FlashTelemetry.h"         /* optional Telemetry */
+#include "..\FlashCompare.h"           /* Compare and Blank Check */
+#if !defined (STM32L562E_DK)
+#include "..\FlashSha256.h"            /* SHA-256 without HASH peripheral */
+#endif
 
 #include "stm32l5xx_hal.h"
+#include "OspiTrace.h"            /* optional OCTOSPI Trace */
 
 #if   defined (STM32L552E_EVAL)
   #include "stm32l552e_eval_ospi.h"
@@ -43,16 +64,450 @@
   #error no board selected!
 #endif
 
+/* OSPI_NOR_LEAN: OspiNor.c replaces HAL OSPI and BSP, no HyperRAM driver */
+#if defined (STM32L552E_EVAL) && !defined (OSPI_NOR_LEAN)
+#define OSPI_RAM_STAGING
+#endif
+
 BSP_OSPI_NOR_Init_t ospi_flash;
 
+extern struct FlashDevice const FlashDevice;
+
+#define ERASE_NONE      0xFFFFFFFFU    /* no erase in progress */
+#define ERASE_CHIP      0xFFFFFFFEU    /* chip erase in progress */
+
+#ifndef ERASE_AHEAD
+#define ERASE_AHEAD     16U            /* 64K blocks queued by EraseSector */
+#endif
+
+static uint32_t EraseBlock;            /* 64K block (or ERASE_CHIP) with erase in progress */
+static uint32_t EraseQueue[ERASE_AHEAD]; /* 64K blocks to be erased, in call order */
+static uint32_t EraseCount;            /* number of queued blocks */
+static uint32_t EraseAhead;            /* queue depth, see EraseAheadDepth */
+static int32_t  EraseStatus;           /* first failed erase since last report */
+
+#if defined FLASH_TELEMETRY
+FlashTelemetry_t FlashTelemetry;       /* read by the host via its FLM symbol */
+#endif
+
+#if defined OSPI_TRACE
+OspiTrace_t OspiTrace;                 /* read by the host via its FLM symbol */
+#endif
+
+#if !defined (OSPI_NOR_LEAN)
+/* Memory-mapped read configurations of Verify, BlankCheck and Digest */
+#define READ_CFG_DIRECT 0U             /* read at OCTOSPI1_BASE, not cached */
+#define READ_CFG_REMAP  1U             /* read through the ICACHE remap at READ_REMAP */
+#define READ_CFG_NUM    2U
+#define READ_CFG_NONE   0xFFFFFFFFU    /* not measured yet */
+
+#ifndef READ_REMAP
+#define READ_REMAP      0x10000000U    /* Code region address of the ICACHE remap */
+#endif
+#ifndef READ_BENCH_SIZE
+#define READ_BENCH_SIZE 0x4000U        /* bytes read per configuration */
+#endif
+
+typedef struct {
+  uint32_t cycles[READ_CFG_NUM];       /* cycles to read READ_BENCH_SIZE bytes */
+  uint32_t size;                       /* READ_BENCH_SIZE */
+  uint32_t cfg;                        /* selected configuration */
+} ReadBench_t;
+
+ReadBench_t ReadBench;                 /* read by the host via its FLM symbol */
+BSP_OSPI_NOR_MemoryMapped_t ospi_mmp;
+#endif
+
+#if defined OSPI_TRACE && !defined (OSPI_NOR_LEAN)
+/*
+ *  OCTOSPI transaction recorder
+ *    armlink redirects calls of these HAL OSPI functions from other objects
+ *    to $Sub$$<name>; $Super$$<name> is the unmodified HAL function.
+ */
+
+extern HAL_StatusTypeDef $Super$$HAL_OSPI_Command      (OSPI_HandleTypeDef *hospi, OSPI_RegularCmdTypeDef *cmd, uint32_t Timeout);
+extern HAL_StatusTypeDef $Super$$HAL_OSPI_Transmit     (OSPI_HandleTypeDef *hospi, uint8_t *pData, uint32_t Timeout);
+extern HAL_StatusTypeDef $Super$$HAL_OSPI_Receive      (OSPI_HandleTypeDef *hospi, uint8_t *pData, uint32_t Timeout);
+extern HAL_StatusTypeDef $Super$$HAL_OSPI_AutoPolling  (OSPI_HandleTypeDef *hospi, OSPI_AutoPollingTypeDef *cfg, uint32_t Timeout);
+extern HAL_StatusTypeDef $Super$$HAL_OSPI_MemoryMapped (OSPI_HandleTypeDef *hospi, OSPI_MemoryMappedTypeDef *cfg);
+
+HAL_StatusTypeDef $Sub$$HAL_OSPI_Command (OSPI_HandleTypeDef *hospi, OSPI_RegularCmdTypeDef *cmd, uint32_t Timeout) {
+  HAL_StatusTypeDef status;
+
+  OspiTraceEnter();
+  status = $Super$$HAL_OSPI_Command(hospi, cmd, Timeout);
+  OspiTraceCmd(cmd, (uint32_t)status);
+
+  return (status);
+}
+
+HAL_StatusTypeDef $Sub$$HAL_OSPI_Transmit (OSPI_HandleTypeDef *hospi, uint8_t *pData, uint32_t Timeout) {
+  HAL_StatusTypeDef status;
+
+  OspiTraceEnter();
+  status = $Super$$HAL_OSPI_Transmit(hospi, pData, Timeout);
+  OspiTraceXfer(hospi, OSPI_TRACE_REC_TX, (uint32_t)status);
+
+  return (status);
+}
+
+HAL_StatusTypeDef $Sub$$HAL_OSPI_Receive (OSPI_HandleTypeDef *hospi, uint8_t *pData, uint32_t Timeout) {
+  HAL_StatusTypeDef status;
+
+  OspiTraceEnter();
+  status = $Super$$HAL_OSPI_Receive(hospi, pData, Timeout);
+  OspiTraceXfer(hospi, OSPI_TRACE_REC_RX, (uint32_t)status);
+
+  return (status);
+}
+
+HAL_StatusTypeDef $Sub$$HAL_OSPI_AutoPolling (OSPI_HandleTypeDef *hospi, OSPI_AutoPollingTypeDef *cfg, uint32_t Timeout) {
+  HAL_StatusTypeDef status;
+
+  OspiTraceEnter();
+  status = $Super$$HAL_OSPI_AutoPolling(hospi, cfg, Timeout);
+  OspiTracePoll(cfg, (uint32_t)status);
+
+  return (status);
+}
+
+HAL_StatusTypeDef $Sub$$HAL_OSPI_MemoryMapped (OSPI_HandleTypeDef *hospi, OSPI_MemoryMappedTypeDef *cfg) {
+  HAL_StatusTypeDef status;
+
+  OspiTraceEnter();
+  status = $Super$$HAL_OSPI_MemoryMapped(hospi, cfg);
+  OspiTraceMmp(cfg, (uint32_t)status);
+
+  return (status);
+}
+#endif
+
 
 /* Private variables ---------------------------------------------------------*/
 extern void SystemInit(void);
 extern void SystemClock_Config(void);
 
+#if !defined (OSPI_NOR_LEAN)
 extern OSPI_HandleTypeDef hospi_nor[1];
+#endif
 extern OSPI_NOR_Ctx_t Ospi_Nor_Ctx[1];
 
+#if defined (OSPI_RAM_STAGING)
+extern OSPI_HandleTypeDef hospi_ram[1];
+extern OSPI_RAM_Ctx_t Ospi_Ram_Ctx[1];
+
+#ifndef STAGE_BUF_SIZE
+#define STAGE_BUF_SIZE  0x1000U        /* HyperRAM to NOR copy chunk */
+#endif
+
+BSP_OSPI_RAM_Init_t ospi_ram;
+
+static uint32_t StageRamInit;          /* HyperRAM is initialized */
+static uint8_t  StageBuf[STAGE_BUF_SIZE];
+#endif
+
+
+/*
+ *  Erase-ahead scheduler
+ *    EraseSector only queues its 64K block. The memory erases one block at
+ *    a time in the background; every call of the algorithm starts the next
+ *    queued block when the previous one is finished. ProgramPage moves the
+ *    block of its page to the front and waits for it, pages of already
+ *    erased blocks are programmed while the running erase is suspended.
+ *    A failed erase is reported by the next ProgramPage, EraseSector,
+ *    Verify, BlankCheck or UnInit.
+ */
+
+/*
+ *  Finish the running erase
+ *    Parameter:      rc:   BSP status of the erase
+ */
+
+static void EraseDone (int32_t rc) {
+
+  EraseBlock = ERASE_NONE;
+  if ((rc != BSP_ERROR_NONE) && (EraseStatus == BSP_ERROR_NONE)) {
+    EraseStatus = rc;
+  }
+}
+
+
+/*
+ *  Remove a block from the erase queue
+ *    Parameter:      n:    Queue index
+ *    Return Value:   64K block address
+ */
+
+static uint32_t EraseDequeue (uint32_t n) {
+  uint32_t blk = EraseQueue[n];
+
+  EraseCount--;
+  for (; n < EraseCount; n++) {
+    EraseQueue[n] = EraseQueue[n + 1U];
+  }
+
+  return (blk);
+}
+
+
+/*
+ *  Start the erase of a 64K block
+ *    Parameter:      blk:  64K block address
+ */
+
+static void EraseStart (uint32_t blk) {
+  int32_t rc;
+
+  rc = BSP_OSPI_NOR_Erase_Block(0, blk, MX25LM51245G_ERASE_64K);
+  if (rc == BSP_ERROR_NONE) {
+    EraseBlock = blk;
+  } else {
+    EraseDone(rc);
+  }
+}
+
+
+/*
+ *  Start the next queued erase when the memory is idle
+ */
+
+static void EraseNext (void) {
+
+  while ((EraseBlock == ERASE_NONE) && (EraseCount != 0U)) {
+    EraseStart(EraseDequeue(0U));
+  }
+}
+
+
+/*
+ *  Check the running erase without waiting, start the next queued one
+ */
+
+static void EraseService (void) {
+  int32_t rc;
+
+  if (EraseBlock != ERASE_NONE) {
+    rc = BSP_OSPI_NOR_GetStatus(0);
+    if (rc == BSP_ERROR_BUSY) {
+      return;
+    }
+    EraseDone(rc);
+  }
+  EraseNext();
+}
+
+
+/*
+ *  Wait until the running erase is finished
+ */
+
+static void EraseWaitCurrent (void) {
+  int32_t rc;
+
+  if (EraseBlock != ERASE_NONE) {
+    FLASH_TLM_SPIN((rc = BSP_OSPI_NOR_GetStatus(0)) == BSP_ERROR_BUSY);
+    EraseDone(rc);
+  }
+}
+
+
+/*
+ *  Erase a block before its pages are programmed
+ *    Parameter:      blk:  64K block address
+ *    A queued block is erased next, ahead of the blocks queued before it.
+ */
+
+static void EraseFirst (uint32_t blk) {
+  uint32_t n;
+
+  if (EraseBlock == ERASE_CHIP) {
+    EraseWaitCurrent();
+  }
+
+  for (n = 0U; n < EraseCount; n++) {
+    if (EraseQueue[n] == blk) {
+      EraseWaitCurrent();
+      EraseStart(EraseDequeue(n));
+      break;
+    }
+  }
+
+  if (EraseBlock == blk) {
+    EraseWaitCurrent();
+  }
+}
+
+
+/*
+ *  Erase-ahead queue depth
+ *    The queued blocks and the running erase must finish within the Erase
+ *    Sector Timeout of FlashDev.c (WaitErase of Verify or UnInit). The
+ *    maximum 64K erase time is taken from the SFDP erase types.
+ *    Return Value:   Number of blocks, 1 to ERASE_AHEAD
+ */
+
+static uint32_t EraseAheadDepth (void) {
+  uint32_t t = MX25LM51245G_SECTOR_ERASE_MAX_TIME;
+  uint32_t n;
+
+  for (n = 0U; n < MX25LM51245G_SFDP_ERASE_NUM; n++) {
+    if ((Ospi_Nor_Ctx[0].Sfdp.EraseSize[n] == MX25LM51245G_SECTOR_64K) && (Ospi_Nor_Ctx[0].Sfdp.EraseMaxTime[n] != 0U)) {
+      t = Ospi_Nor_Ctx[0].Sfdp.EraseMaxTime[n];
+    }
+  }
+
+  n = FlashDevice.toErase / t;
+  if (n > ERASE_AHEAD + 1U) {
+    n = ERASE_AHEAD + 1U;
+  }
+
+  return ((n > 1U) ? (n - 1U) : 1U);
+}
+
+
+/*
+ *  Wait until all queued erases are finished
+ *    Return Value:   BSP status of the erases (first error)
+ */
+
+static int32_t WaitErase (void) {
+  int32_t rc;
+
+  do {
+    EraseWaitCurrent();
+    EraseNext();
+  } while (EraseBlock != ERASE_NONE);
+
+  rc = EraseStatus;
+  EraseStatus = BSP_ERROR_NONE;
+
+  return (rc);
+}
+
+
+#if !defined (OSPI_NOR_LEAN)
+/*
+ *  Enter memory-mapped mode with a read configuration
+ *    Parameter:      cfg:  READ_CFG_DIRECT, READ_CFG_REMAP
+ *    Return Value:   BSP status
+ */
+
+static int32_t ReadEnable (uint32_t cfg) {
+  int32_t rc;
+
+  ospi_mmp.CacheRemap = (cfg == READ_CFG_REMAP) ? READ_REMAP : BSP_OSPI_NOR_CACHE_REMAP_NONE;
+  ospi_mmp.CacheBurst = BSP_OSPI_NOR_CACHE_BURST_INCR;
+
+  rc = BSP_OSPI_NOR_ConfigMemoryMappedMode(0, &ospi_mmp);
+  if (rc == BSP_ERROR_NONE) {
+    rc = BSP_OSPI_NOR_EnableMemoryMappedMode(0);
+  }
+
+  return (rc);
+}
+
+
+/*
+ *  Read benchmark
+ *    Each read configuration reads READ_BENCH_SIZE bytes from the start of
+ *    the memory, the fastest one is used by the read functions of the
+ *    session. Results are kept in ReadBench.
+ *    Return Value:   BSP status
+ */
+
+static int32_t ReadMeasure (void) {
+  const volatile uint32_t *p;
+  uint32_t cfg, best, t, i;
+  uint32_t x = 0U;
+  int32_t  rc;
+
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+  best = READ_CFG_DIRECT;
+  for (cfg = 0U; cfg < READ_CFG_NUM; cfg++) {
+    rc = ReadEnable(cfg);
+    if (rc != BSP_ERROR_NONE) {
+      return (rc);
+    }
+
+    p = (const volatile uint32_t *)((cfg == READ_CFG_REMAP) ? READ_REMAP : OCTOSPI1_BASE);
+    t = DWT->CYCCNT;
+    for (i = 0U; i < (READ_BENCH_SIZE / 4U); i += 4U) {
+      x ^= p[i] ^ p[i + 1U] ^ p[i + 2U] ^ p[i + 3U];
+    }
+    ReadBench.cycles[cfg] = DWT->CYCCNT - t;
+
+    rc = BSP_OSPI_NOR_DisableMemoryMappedMode(0);
+    if (rc != BSP_ERROR_NONE) {
+      return (rc);
+    }
+    if (ReadBench.cycles[cfg] < ReadBench.cycles[best]) {
+      best = cfg;
+    }
+  }
+  (void)x;
+
+  ReadBench.size = READ_BENCH_SIZE;
+  ReadBench.cfg  = best;
+
+  return (BSP_ERROR_NONE);
+}
+#endif
+
+
+/*
+ *  Enter memory-mapped mode for Verify, BlankCheck and Digest
+ *    Parameter:      adr:  Start Address (memory-mapped at OCTOSPI1_BASE)
+ *    Return Value:   Address to read adr from, 0 - Failed
+ */
+
+static uint32_t ReadBegin (uint32_t adr) {
+
+  if (WaitErase() != BSP_ERROR_NONE) {
+    return (0U);
+  }
+
+  FLASH_TLM_MODE();
+#if !defined (OSPI_NOR_LEAN)
+  if (ReadBench.cfg == READ_CFG_NONE) {
+    if (ReadMeasure() != BSP_ERROR_NONE) {
+      return (0U);
+    }
+  }
+  if (ReadEnable(ReadBench.cfg) != BSP_ERROR_NONE) {
+    return (0U);
+  }
+  if (ReadBench.cfg == READ_CFG_REMAP) {
+    adr = (adr - OCTOSPI1_BASE) + READ_REMAP;
+  }
+#else
+  if (BSP_OSPI_NOR_EnableMemoryMappedMode(0) != BSP_ERROR_NONE) {
+    return (0U);
+  }
+#endif
+
+  return (adr);
+}
+
+
+/*
+ *  Leave memory-mapped mode
+ *    Return Value:   BSP status
+ */
+
+static int32_t ReadEnd (void) {
+  int32_t rc;
+
+  FLASH_TLM_MODE();
+  rc = BSP_OSPI_NOR_DisableMemoryMappedMode(0);
+  if (rc == BSP_ERROR_NONE) {
+    rc = BSP_OSPI_NOR_ConfigFlash(0, ospi_flash.InterfaceMode, ospi_flash.TransferRate);
+  }
+
+  return (rc);
+}
+
 
 /*
  *  Initialize Flash Programming Functions
@@ -65,20 +520,44 @@ extern OSPI_NOR_Ctx_t Ospi_Nor_Ctx[1];
 int Init (unsigned long adr, unsigned long clk, unsigned long fnc) {
   int32_t rc;
 
+  FLASH_TLM_BEGIN(FLASH_TLM_INIT, adr, 0);
+  OSPI_TRACE_INIT();
+
   __disable_irq();
 
+#if !defined (OSPI_NOR_LEAN)
   memset(&hospi_nor,0,sizeof(hospi_nor));
+#endif
   memset(&Ospi_Nor_Ctx,0,sizeof(Ospi_Nor_Ctx));
+#if defined (OSPI_RAM_STAGING)
+  memset(&hospi_ram,0,sizeof(hospi_ram));
+  memset(&Ospi_Ram_Ctx,0,sizeof(Ospi_Ram_Ctx));
+
+  ospi_ram.LatencyType = BSP_OSPI_RAM_FIXED_LATENCY;
+  ospi_ram.BurstType   = BSP_OSPI_RAM_LINEAR_BURST;
+  ospi_ram.BurstLength = BSP_OSPI_RAM_BURST_32_BYTES;
+  StageRamInit = 0U;
+#endif
+  EraseBlock  = ERASE_NONE;
+  EraseCount  = 0U;
+  EraseStatus = BSP_ERROR_NONE;
 
   ospi_flash.InterfaceMode = BSP_OSPI_NOR_OPI_MODE;
   ospi_flash.TransferRate  = BSP_OSPI_NOR_DTR_TRANSFER;
 
   SystemInit();
+  FLASH_TLM_PHASE(FLASH_TLM_PH_SYSINIT);
   SystemClock_Config();          /* configure system core clock */
+  FLASH_TLM_PHASE(FLASH_TLM_PH_CLOCK);
 //  SystemCoreClockUpdate();
 
   rc = BSP_OSPI_NOR_Init(0, &ospi_flash);
-  return ((rc == BSP_ERROR_NONE) ? 0 : 1);
+  EraseAhead = EraseAheadDepth();
+#if !defined (OSPI_NOR_LEAN)
+  ospi_mmp = Ospi_Nor_Ctx[0].MemoryMapped;       /* BSP default, ICACHE remap set per read */
+  ReadBench.cfg = READ_CFG_NONE;                 /* measured by the first read function */
+#endif
+  return (FLASH_TLM_RET(FLASH_TLM_INIT, (rc == BSP_ERROR_NONE) ? 0 : 1));
 }
 
 
@@ -89,11 +568,22 @@ int Init (unsigned long adr, unsigned long clk, unsigned long fnc) {
  */
 
 int UnInit (unsigned long fnc) {
-  int32_t rc;
+  int32_t rc, rc_erase;
+
+  FLASH_TLM_BEGIN(FLASH_TLM_UNINIT, 0, 0);
 
+  rc_erase = WaitErase();              /* reset in next Init would abort queued erases */
+#if defined (OSPI_RAM_STAGING)
+  if (StageRamInit != 0U) {
+    if (BSP_OSPI_RAM_DeInit(0) != BSP_ERROR_NONE) {
+      rc_erase = BSP_ERROR_PERIPH_FAILURE;
+    }
+    StageRamInit = 0U;
+  }
+#endif
   rc = BSP_OSPI_NOR_DeInit(0);
 
-  return ((rc == BSP_ERROR_NONE) ? 0 : 1);
+  return (FLASH_TLM_RET(FLASH_TLM_UNINIT, ((rc == BSP_ERROR_NONE) && (rc_erase == BSP_ERROR_NONE)) ? 0 : 1));
 }
 
 
@@ -103,21 +593,15 @@ int UnInit (unsigned long fnc) {
  */
 
 int EraseChip (void) {
-  int32_t rc;
 
-  rc = BSP_OSPI_NOR_Erase_Chip(0);
+  FLASH_TLM_BEGIN(FLASH_TLM_ERASECHIP, 0, 0);
 
-  if (rc != BSP_ERROR_NONE) {
-    return (1);
+  if (StartEraseChip() != 0) {
+    return (FLASH_TLM_RET(FLASH_TLM_ERASECHIP, 1));
   }
 
   /* Wait the end of the current operation on memory side */
-  do
-  {
-    rc = BSP_OSPI_NOR_GetStatus(0);
-  } while((rc != BSP_ERROR_NONE) && (rc != BSP_ERROR_COMPONENT_FAILURE));
-
-  return ((rc == BSP_ERROR_NONE) ? 0 : 1);
+  return (FLASH_TLM_RET(FLASH_TLM_ERASECHIP, (WaitErase() == BSP_ERROR_NONE) ? 0 : 1));
 }
 
 
@@ -125,24 +609,100 @@ int EraseChip (void) {
  *  Erase Sector in Flash Memory
  *    Parameter:      adr:  Sector Address
  *    Return Value:   0 - OK,  1 - Failed
+ *    The erase is queued (erase-ahead), it runs while the next
+ *    sectors are queued and pages of erased sectors are programmed.
  */
 
 int EraseSector (unsigned long adr) {
+
+  FLASH_TLM_BEGIN(FLASH_TLM_ERASESECTOR, adr, 0);
+
+  return (FLASH_TLM_RET(FLASH_TLM_ERASESECTOR, StartErase(adr)));
+}
+
+
+/*
+ *  Start Erase of complete Flash Memory
+ *    Return Value:   0 - OK,  1 - Failed
+ *    Completion is checked with PollOperation
+ */
+
+int StartEraseChip (void) {
   int32_t rc;
 
-  rc = BSP_OSPI_NOR_Erase_Block(0, (uint32_t)(adr & 0x0FFFFFFF),  MX25LM51245G_ERASE_64K);
+  if (WaitErase() != BSP_ERROR_NONE) {
+    return (1);
+  }
+
+  rc = BSP_OSPI_NOR_Erase_Chip(0);
 
   if (rc != BSP_ERROR_NONE) {
     return (1);
   }
 
-  /* Wait the end of the current operation on memory side */
-  do
-  {
-    rc = BSP_OSPI_NOR_GetStatus(0);
-  } while((rc != BSP_ERROR_NONE) && (rc != BSP_ERROR_COMPONENT_FAILURE));
+  EraseBlock = ERASE_CHIP;
 
-  return ((rc == BSP_ERROR_NONE) ? 0 : 1);
+  return (0);
+}
+
+
+/*
+ *  Start Erase of Sector in Flash Memory
+ *    Parameter:      adr:  Sector Address
+ *    Return Value:   0 - OK,  1 - Failed
+ *    The sector is added to the erase queue, completion of all
+ *    queued erases is checked with PollOperation
+ */
+
+int StartErase (unsigned long adr) {
+  uint32_t blk = (uint32_t)(adr & 0x0FFFFFFF) & ~(MX25LM51245G_SECTOR_64K - 1U);
+  uint32_t n;
+
+  EraseService();
+  if (EraseCount >= EraseAhead) {
+    EraseWaitCurrent();                /* queue full, wait for the running erase */
+    EraseNext();
+  }
+
+  if (EraseStatus != BSP_ERROR_NONE) {
+    return (1);                        /* a queued erase failed */
+  }
+
+  if (EraseBlock == blk) {
+    return (0);                        /* already erasing */
+  }
+  for (n = 0U; n < EraseCount; n++) {
+    if (EraseQueue[n] == blk) {
+      return (0);                      /* already queued */
+    }
+  }
+
+  EraseQueue[EraseCount++] = blk;
+  EraseNext();
+
+  return ((EraseStatus == BSP_ERROR_NONE) ? 0 : 1);
+}
+
+
+/*
+ *  Poll started Operation
+ *    Return Value:   OP_DONE, OP_BUSY, OP_ERROR
+ *    Memory status is read from WIP (Status Register) and
+ *    P_FAIL/E_FAIL (Security Register)
+ */
+
+int PollOperation (void) {
+  int32_t rc;
+
+  EraseService();
+  if (EraseBlock != ERASE_NONE) {
+    return (OP_BUSY);
+  }
+
+  rc = EraseStatus;
+  EraseStatus = BSP_ERROR_NONE;
+
+  return ((rc == BSP_ERROR_NONE) ? OP_DONE : OP_ERROR);
 }
 
 
@@ -155,11 +715,45 @@ int EraseSector (unsigned long adr) {
  */
 
 int ProgramPage (unsigned long adr, unsigned long sz, unsigned char *buf) {
+  uint32_t suspended = 0U;
   int32_t rc;
 
+  FLASH_TLM_BEGIN(FLASH_TLM_PROGRAMPAGE, adr, sz);
+
+  EraseService();
+  EraseFirst((uint32_t)(adr & 0x0FFFFFFF) & ~(MX25LM51245G_SECTOR_64K - 1U));
+  EraseNext();                         /* next queued block erases meanwhile */
+
+  if (EraseStatus != BSP_ERROR_NONE) {
+    return (FLASH_TLM_RET(FLASH_TLM_PROGRAMPAGE, 1));
+  }
+
+  if (EraseBlock != ERASE_NONE) {
+    if (BSP_OSPI_NOR_SuspendErase(0) == BSP_ERROR_NONE) {
+      /* Page is in an already erased block, program it while erase is suspended */
+      suspended = 1U;
+    } else {
+      /* Erase finished before it could be suspended */
+      EraseWaitCurrent();
+      if (EraseStatus != BSP_ERROR_NONE) {
+        return (FLASH_TLM_RET(FLASH_TLM_PROGRAMPAGE, 1));
+      }
+    }
+  }
+
   rc = BSP_OSPI_NOR_Write(0, (uint8_t*)buf, (uint32_t)(adr & 0x0FFFFFFF), (uint32_t)sz);
 
-  return ((rc == BSP_ERROR_NONE) ? 0 : 1);
+  if (suspended != 0U) {
+    if (BSP_OSPI_NOR_ResumeErase(0) != BSP_ERROR_NONE) {
+      /* Erase may have completed right after resume */
+      EraseWaitCurrent();
+      if (EraseStatus != BSP_ERROR_NONE) {
+        rc = BSP_ERROR_COMPONENT_FAILURE;
+      }
+    }
+  }
+
+  return (FLASH_TLM_RET(FLASH_TLM_PROGRAMPAGE, (rc == BSP_ERROR_NONE) ? 0 : 1));
 }
 
 
@@ -171,32 +765,23 @@ int ProgramPage (unsigned long adr, unsigned long sz, unsigned char *buf) {
   *    Return Value:   (adr+sz) - OK, Failed Address
  */
 unsigned long Verify (unsigned long adr, unsigned long sz, unsigned char *buf){
-  uint8_t * ptr = (uint8_t *)adr;
-  uint32_t i;
-  int32_t rc;
+  unsigned long res;
+  uint32_t mem;
 
-  rc = BSP_OSPI_NOR_EnableMemoryMappedMode(0);
-  if (rc != BSP_ERROR_NONE) {
-    return (adr);
-  }
+  FLASH_TLM_BEGIN(FLASH_TLM_VERIFY, adr, sz);
 
-  for(i = 0; i < sz; i++)
-  {
-    if (ptr[i] != buf[i])
-      return (adr + i);                /* Verification Failed (return address) */
+  mem = ReadBegin((uint32_t)adr);
+  if (mem == 0U) {
+    return (FLASH_TLM_RET_ADR(FLASH_TLM_VERIFY, adr, adr + sz));
   }
 
-  rc = BSP_OSPI_NOR_DisableMemoryMappedMode(0);
-  if (rc != BSP_ERROR_NONE) {
-    return (adr);
-  }
-  rc = BSP_OSPI_NOR_ConfigFlash(0, ospi_flash.InterfaceMode, ospi_flash.TransferRate);
-  if (rc != BSP_ERROR_NONE) {
-    return (adr);
-  }
+  res = adr + FlashCompare((const unsigned char *)mem, buf, sz);      /* Failed address or (adr+sz) */
 
+  if (ReadEnd() != BSP_ERROR_NONE) {
+    return (FLASH_TLM_RET_ADR(FLASH_TLM_VERIFY, adr, adr + sz));
+  }
 
-  return (adr + sz);                   /* Done successfully */
+  return (FLASH_TLM_RET_ADR(FLASH_TLM_VERIFY, res, adr + sz));
 }
 
 
@@ -207,27 +792,216 @@ unsigned long Verify (unsigned long adr, unsigned long sz, unsigned char *buf){
  *    Return Value:   0 - OK,  1 - Failed
  */
 int BlankCheck  (unsigned long adr, unsigned long sz, unsigned char pat) {
-  uint8_t * ptr = (uint8_t *)adr;
-  uint32_t i = 0;
-  int result = 0;
+  int result;
+  uint32_t mem;
+
+  FLASH_TLM_BEGIN(FLASH_TLM_BLANKCHECK, adr, sz);
+
+  mem = ReadBegin((uint32_t)adr);
+  if (mem == 0U) {
+    return (FLASH_TLM_RET(FLASH_TLM_BLANKCHECK, 1));
+  }
+
+  result = (FlashBlank((const unsigned char *)mem, sz, pat) != sz) ? 1 : 0;
+
+  if (ReadEnd() != BSP_ERROR_NONE) {
+    result = 1;
+  }
+
+  return (FLASH_TLM_RET(FLASH_TLM_BLANKCHECK, result));
+}
+
+
+#if defined (STM32L562E_DK)
+/*
+ *  SHA-256 with HASH peripheral
+ *    Parameter:      mem:  Data Address
+ *                    sz:   Size (in bytes)
+ *                    dgst: Digest (DIGEST_SIZE bytes)
+ */
+static void HashSha256 (const uint8_t *mem, uint32_t sz, uint8_t *dgst) {
+  uint32_t w;
+  uint32_t i, n;
+
+  __HAL_RCC_HASH_CLK_ENABLE();
+
+  HASH->CR = HASH_CR_ALGO_1 | HASH_CR_ALGO_0 | HASH_CR_DATATYPE_1;  /* SHA-256, byte data */
+  HASH->CR |= HASH_CR_INIT;
+  MODIFY_REG(HASH->STR, HASH_STR_NBLW, 8U * (sz & 3U));             /* valid bits of last word */
+
+  for (i = 0U; i < sz; i += 4U) {
+    if ((((uint32_t)mem & 3U) == 0U) && ((sz - i) >= 4U)) {
+      w = *((const uint32_t *)(mem + i));
+    } else {
+      w = 0U;
+      for (n = 0U; (n < 4U) && ((i + n) < sz); n++) {
+        w |= (uint32_t)mem[i + n] << (8U * n);
+      }
+    }
+    HASH->DIN = w;
+  }
+
+  SET_BIT(HASH->STR, HASH_STR_DCAL);
+  FLASH_TLM_SPIN((HASH->SR & HASH_SR_DCIS) == 0U);
+
+  for (i = 0U; i < 8U; i++) {
+    w = HASH_DIGEST->HR[i];
+    dgst[4U*i]    = (uint8_t)(w >> 24);
+    dgst[4U*i+1U] = (uint8_t)(w >> 16);
+    dgst[4U*i+2U] = (uint8_t)(w >>  8);
+    dgst[4U*i+3U] = (uint8_t)(w      );
+  }
+
+  __HAL_RCC_HASH_CLK_DISABLE();
+}
+#endif
+
+
+/*
+ *  Calculate Digest of Flash Contents
+ *    Parameter:      adr:  Start Address
+ *                    sz:   Size (in bytes)
+ *                    buf:  Digest (SHA-256, DIGEST_SIZE bytes)
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+int Digest (unsigned long adr, unsigned long sz, unsigned char *buf) {
+  uint32_t mem;
+
+  FLASH_TLM_BEGIN(FLASH_TLM_DIGEST, adr, sz);
+
+  mem = ReadBegin((uint32_t)adr);
+  if (mem == 0U) {
+    return (FLASH_TLM_RET(FLASH_TLM_DIGEST, 1));
+  }
+
+#if defined (STM32L562E_DK)
+  HashSha256((const uint8_t *)mem, sz, buf);
+#else
+  FlashSha256((const unsigned char *)mem, sz, buf);          /* no HASH peripheral on STM32L552 */
+#endif
+
+  return (FLASH_TLM_RET(FLASH_TLM_DIGEST, (ReadEnd() == BSP_ERROR_NONE) ? 0 : 1));
+}
+
+
+#if defined (OSPI_RAM_STAGING)
+/*
+ *  HyperRAM staging (STM32L552E-EVAL)
+ *    NOR Flash and HyperRAM share OCTOSPI1, only one of them is configured at a time.
+ *    Each memory is initialized once (NOR Flash in Init, HyperRAM in the first
+ *    StageBegin), switching between them only reconfigures OCTOSPI1.
+ *    1. StageBegin:    HyperRAM is memory-mapped at 0x90000000,
+ *                      the host downloads the image there with plain memory writes
+ *    2. StageProgram:  NOR Flash is programmed from HyperRAM in STAGE_BUF_SIZE chunks
+ *    3. StageEnd:      NOR Flash is configured again
+ *    Sectors must be erased before StageProgram is called.
+ */
+
+/*
+ *  Configure OCTOSPI1 for HyperRAM (memory-mapped)
+ *    Return Value:   BSP status
+ */
+
+static int32_t SelectOSPIRam (void) {
   int32_t rc;
 
+  /* NOR Flash must be idle while OCTOSPI1 serves the HyperRAM */
+  rc = WaitErase();
+  if (rc != BSP_ERROR_NONE) {
+    return (rc);
+  }
+
+  FLASH_TLM_MODE();
+  if (StageRamInit == 0U) {
+    rc = BSP_OSPI_RAM_Init(0, &ospi_ram);          /* NOR Flash stays in its mode */
+    if (rc == BSP_ERROR_NONE) {
+      StageRamInit = 1U;
+    }
+  } else {
+    rc = BSP_OSPI_RAM_Select(0);
+  }
+  if (rc != BSP_ERROR_NONE) {
+    return (rc);
+  }
 
-  rc = BSP_OSPI_NOR_EnableMemoryMappedMode(0);
+  return (BSP_OSPI_RAM_EnableMemoryMappedMode(0));
+}
 
-  for (i = 0; i < sz; i++)
-  {
-    if(ptr[i] != pat) {
-      result = 1;
-      break;
+
+/*
+ *  Configure OCTOSPI1 for NOR Flash
+ *    Return Value:   BSP status
+ */
+
+static int32_t SelectOSPINor (void) {
+
+  FLASH_TLM_MODE();
+  return (BSP_OSPI_NOR_Select(0));
+}
+
+
+/*
+ *  Make HyperRAM available for download
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int StageBegin (void) {
+
+  return ((SelectOSPIRam() == BSP_ERROR_NONE) ? 0 : 1);
+}
+
+
+/*
+ *  Program NOR Flash from HyperRAM
+ *    Parameter:      adr:  NOR Flash Start Address
+ *                    ofs:  Offset of data in HyperRAM
+ *                    sz:   Size (in bytes)
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int StageProgram (unsigned long adr, unsigned long ofs, unsigned long sz) {
+  uint32_t n;
+  int32_t rc;
+
+  while (sz != 0U) {
+    n = (sz > STAGE_BUF_SIZE) ? STAGE_BUF_SIZE : (uint32_t)sz;
+
+    rc = SelectOSPIRam();
+    if (rc != BSP_ERROR_NONE) {
+      return (1);
+    }
+    memcpy(StageBuf, (const uint8_t *)(OCTOSPI1_BASE + ofs), n);  /* AHB burst reads */
+
+    rc = SelectOSPINor();
+    if (rc == BSP_ERROR_NONE) {
+      rc = BSP_OSPI_NOR_Write(0, StageBuf, (uint32_t)(adr & 0x0FFFFFFF), n);
+    }
+    if (rc != BSP_ERROR_NONE) {
+      return (1);
     }
+
+    adr += n;
+    ofs += n;
+    sz  -= n;
   }
 
-  rc = BSP_OSPI_NOR_DisableMemoryMappedMode(0);
-  rc = BSP_OSPI_NOR_ConfigFlash(0, ospi_flash.InterfaceMode, ospi_flash.TransferRate);
+  return (0);
+}
+
 
-  return (result);
+/*
+ *  Return OCTOSPI1 to NOR Flash
+ *    Return Value:   0 - OK,  1 - Failed
+ */
+
+int StageEnd (void) {
+  int32_t rc;
+
+  rc = SelectOSPINor();
+
+  return ((rc == BSP_ERROR_NONE) ? 0 : 1);
 }
+#endif /* OSPI_RAM_STAGING */
 
 
 /* -- helper functions for test application -- */
@@ -0,0 +1,820 @@
+/* -----------------------------------------------------------------------------
+ * Copyright (c) 2026 ARM Ltd.
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software. Permission is granted to anyone to use this
+ * software for any purpose, including commercial applications, and to alter
+ * it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V1.00
+ *
+ * Project:      Register-level OSPI NOR driver for the Flash algorithm
+ *               (MX25LM51245G in octal DTR mode)
+ * --------------------------------------------------------------------------- */
+
+/* History:
+ *  Version 1.00
+ *    Initial release
+ */
+
+/* Replaces HAL OSPI/GPIO/DMA, the board BSP and the mx25lm51245g component
+ * in the *_Lean targets (OSPI_NOR_LEAN). The BSP_OSPI_NOR functions used by
+ * FlashPrg.c are implemented with the prototypes and return codes of the
+ * board BSP, for the OPI DTR mode only.
+ * Opcodes, dummy cycles and register bits are taken from mx25lm51245g.h and
+ * mx25lm51245g_conf.h, pins and the clock prescaler from the board BSP
+ * header; the command sequences are those of the component and the BSP.
+ */
+
+#include "..\FlashTelemetry.h"         /* optional Telemetry */
+
+#include "stm32l5xx_hal.h"
+
+#if   defined (STM32L552E_EVAL)
+  #include "stm32l552e_eval_ospi.h"
+#elif defined (STM32L562E_DK)
+  #include "stm32l562e_discovery_ospi.h"
+#else
+  #error no board selected!
+#endif
+
+#define NOR_FTHRES      4U             /* FIFO threshold in bytes (as BSP) */
+#define NOR_CSHT        2U             /* Chip select high time in cycles (as BSP) */
+
+/* OCTOSPI_CR functional mode */
+#define NOR_FMODE_WRITE (0U << OCTOSPI_CR_FMODE_Pos)
+#define NOR_FMODE_READ  (1U << OCTOSPI_CR_FMODE_Pos)
+#define NOR_FMODE_POLL  (2U << OCTOSPI_CR_FMODE_Pos)
+#define NOR_FMODE_MMP   (3U << OCTOSPI_CR_FMODE_Pos)
+
+/* OCTOSPI_CCR phases: SPI (1-1-1), STR OPI and DTR OPI (8-8-8) */
+#define NOR_SPI_I       (OCTOSPI_CCR_IMODE_0)
+#define NOR_SPI_A       (OCTOSPI_CCR_ADMODE_0 | OCTOSPI_CCR_ADSIZE)
+#define NOR_SPI_D       (OCTOSPI_CCR_DMODE_0)
+#define NOR_SOPI_I      (OCTOSPI_CCR_IMODE_2  | OCTOSPI_CCR_ISIZE_0)
+#define NOR_DOPI_I      (OCTOSPI_CCR_IMODE_2  | OCTOSPI_CCR_ISIZE_0 | OCTOSPI_CCR_IDTR)
+#define NOR_DOPI_A      (OCTOSPI_CCR_ADMODE_2 | OCTOSPI_CCR_ADSIZE  | OCTOSPI_CCR_ADDTR)
+#define NOR_DOPI_D      (OCTOSPI_CCR_DMODE_2  | OCTOSPI_CCR_DDTR)
+#define NOR_DOPI_REG    (NOR_DOPI_I | NOR_DOPI_A | NOR_DOPI_D | OCTOSPI_CCR_DQSE)
+
+typedef struct {
+  GPIO_TypeDef *port;
+  uint32_t      pin;
+  uint32_t      af;
+  uint32_t      pull;
+} NorPin_t;
+
+static const NorPin_t NorPins[] = {
+  { OSPI_CS_GPIO_PORT,  OSPI_CS_PIN,  OSPI_CS_PIN_AF,  GPIO_PULLUP },
+  { OSPI_DQS_GPIO_PORT, OSPI_DQS_PIN, OSPI_DQS_PIN_AF, GPIO_PULLUP },
+  { OSPI_CLK_GPIO_PORT, OSPI_CLK_PIN, OSPI_CLK_PIN_AF, GPIO_NOPULL },
+  { OSPI_D0_GPIO_PORT,  OSPI_D0_PIN,  OSPI_D0_PIN_AF,  GPIO_NOPULL },
+  { OSPI_D1_GPIO_PORT,  OSPI_D1_PIN,  OSPI_D1_PIN_AF,  GPIO_NOPULL },
+  { OSPI_D2_GPIO_PORT,  OSPI_D2_PIN,  OSPI_D2_PIN_AF,  GPIO_NOPULL },
+  { OSPI_D3_GPIO_PORT,  OSPI_D3_PIN,  OSPI_D3_PIN_AF,  GPIO_NOPULL },
+  { OSPI_D4_GPIO_PORT,  OSPI_D4_PIN,  OSPI_D4_PIN_AF,  GPIO_NOPULL },
+  { OSPI_D5_GPIO_PORT,  OSPI_D5_PIN,  OSPI_D5_PIN_AF,  GPIO_NOPULL },
+  { OSPI_D6_GPIO_PORT,  OSPI_D6_PIN,  OSPI_D6_PIN_AF,  GPIO_NOPULL },
+  { OSPI_D7_GPIO_PORT,  OSPI_D7_PIN,  OSPI_D7_PIN_AF,  GPIO_NOPULL }
+};
+
+#define NOR_PIN_NUM     (sizeof(NorPins) / sizeof(NorPins[0]))
+
+/* Reset Enable and Reset Memory in every mode the memory may be in */
+static const uint32_t NorResetSeq[][2] = {
+  { NOR_SPI_I,  MX25LM51245G_RESET_ENABLE_CMD      },
+  { NOR_SPI_I,  MX25LM51245G_RESET_MEMORY_CMD      },
+  { NOR_SOPI_I, MX25LM51245G_OCTA_RESET_ENABLE_CMD },
+  { NOR_SOPI_I, MX25LM51245G_OCTA_RESET_MEMORY_CMD },
+  { NOR_DOPI_I, MX25LM51245G_OCTA_RESET_ENABLE_CMD },
+  { NOR_DOPI_I, MX25LM51245G_OCTA_RESET_MEMORY_CMD }
+};
+
+#define NOR_RESET_NUM   (sizeof(NorResetSeq) / sizeof(NorResetSeq[0]))
+
+OSPI_NOR_Ctx_t Ospi_Nor_Ctx[OSPI_NOR_INSTANCES_NUMBER];
+
+
+/*
+ *  Configure Pin for OCTOSPI (alternate function, very high speed)
+ *    Parameter:      p:    Pin
+ */
+
+static void NorPinInit (const NorPin_t *p) {
+  uint32_t pos = POSITION_VAL(p->pin);
+  uint32_t afr = (pos & 7U) * 4U;
+
+  p->port->AFR[pos >> 3] = (p->port->AFR[pos >> 3] & ~(0xFU << afr)) | (p->af << afr);
+  p->port->OSPEEDR      |= (3U << (2U * pos));
+  p->port->OTYPER       &= ~(1U << pos);
+  p->port->PUPDR         = (p->port->PUPDR & ~(3U << (2U * pos))) | (p->pull << (2U * pos));
+  p->port->MODER         = (p->port->MODER & ~(3U << (2U * pos))) | (2U << (2U * pos));
+}
+
+
+/*
+ *  Return Pin to reset state (analog)
+ *    Parameter:      p:    Pin
+ */
+
+static void NorPinDeInit (const NorPin_t *p) {
+  uint32_t pos = POSITION_VAL(p->pin);
+
+  p->port->MODER        |= (3U << (2U * pos));
+  p->port->PUPDR        &= ~(3U << (2U * pos));
+  p->port->OSPEEDR      &= ~(3U << (2U * pos));
+  p->port->AFR[pos >> 3] &= ~(0xFU << ((pos & 7U) * 4U));
+}
+
+
+/*
+ *  Start Command
+ *    Parameter:      fmode: Functional mode (OCTOSPI_CR)
+ *                    ccr:   Phases (OCTOSPI_CCR)
+ *                    dcyc:  Dummy cycles
+ *                    inst:  Instruction
+ *                    adr:   Address (if ccr has an address phase)
+ *                    n:     Number of data bytes (if ccr has a data phase)
+ *    The command starts with the write of IR (no address) or AR;
+ *    in indirect write mode with data it starts with the first data.
+ */
+
+static void NorCommand (uint32_t fmode, uint32_t ccr, uint32_t dcyc, uint32_t inst, uint32_t adr, uint32_t n) {
+
+  while ((OCTOSPI1->SR & OCTOSPI_SR_BUSY) != 0U);
+
+  OCTOSPI1->CR  = (OCTOSPI1->CR  & ~OCTOSPI_CR_FMODE) | fmode;
+  if ((ccr & OCTOSPI_CCR_DMODE) != 0U) {
+    OCTOSPI1->DLR = n - 1U;
+  }
+  OCTOSPI1->TCR = (OCTOSPI1->TCR & ~OCTOSPI_TCR_DCYC) | dcyc;
+  OCTOSPI1->CCR = ccr;
+  OCTOSPI1->IR  = inst;
+  if ((ccr & OCTOSPI_CCR_ADMODE) != 0U) {
+    OCTOSPI1->AR = adr;
+  }
+}
+
+
+/*
+ *  Wait for end of Command
+ *    Return Value:   BSP status
+ */
+
+static int32_t NorComplete (void) {
+  uint32_t sr;
+
+  do {
+    sr = OCTOSPI1->SR;
+  } while ((sr & (OCTOSPI_SR_TCF | OCTOSPI_SR_TEF)) == 0U);
+  OCTOSPI1->FCR = OCTOSPI_FCR_CTCF | OCTOSPI_FCR_CTEF;
+
+  return (((sr & OCTOSPI_SR_TEF) != 0U) ? BSP_ERROR_PERIPH_FAILURE : BSP_ERROR_NONE);
+}
+
+
+/*
+ *  Send Command without data
+ *    Parameter:      ccr:  Phases (OCTOSPI_CCR)
+ *                    inst: Instruction
+ *                    adr:  Address
+ *    Return Value:   BSP status
+ */
+
+static int32_t NorSend (uint32_t ccr, uint32_t inst, uint32_t adr) {
+
+  NorCommand(NOR_FMODE_WRITE, ccr, 0U, inst, adr, 0U);
+
+  return (NorComplete());
+}
+
+
+/*
+ *  Send Command with data to the memory
+ *    Parameter:      ccr:  Phases (OCTOSPI_CCR)
+ *                    inst: Instruction
+ *                    adr:  Address
+ *                    buf:  Data
+ *                    n:    Number of bytes
+ *    Return Value:   BSP status
+ */
+
+static int32_t NorWrite (uint32_t ccr, uint32_t inst, uint32_t adr, const uint8_t *buf, uint32_t n) {
+  uint32_t i = 0U;
+
+  NorCommand(NOR_FMODE_WRITE, ccr, 0U, inst, adr, n);
+
+  /* FTF: at least NOR_FTHRES bytes free in the FIFO */
+  for (; (n - i) >= 4U; i += 4U) {
+    while ((OCTOSPI1->SR & (OCTOSPI_SR_FTF | OCTOSPI_SR_TEF)) == 0U);
+    OCTOSPI1->DR = (uint32_t)buf[i]             | ((uint32_t)buf[i + 1U] << 8) |
+                  ((uint32_t)buf[i + 2U] << 16) | ((uint32_t)buf[i + 3U] << 24);
+  }
+  for (; i < n; i++) {
+    while ((OCTOSPI1->SR & (OCTOSPI_SR_FTF | OCTOSPI_SR_TEF)) == 0U);
+    *((__IO uint8_t *)&OCTOSPI1->DR) = buf[i];
+  }
+
+  return (NorComplete());
+}
+
+
+/*
+ *  Send Command with data from the memory
+ *    Parameter:      ccr:  Phases (OCTOSPI_CCR)
+ *                    dcyc: Dummy cycles
+ *                    inst: Instruction
+ *                    adr:  Address
+ *                    buf:  Data
+ *                    n:    Number of bytes
+ *    Return Value:   BSP status
+ */
+
+static int32_t NorRead (uint32_t ccr, uint32_t dcyc, uint32_t inst, uint32_t adr, uint8_t *buf, uint32_t n) {
+  uint32_t i;
+
+  NorCommand(NOR_FMODE_READ, ccr, dcyc, inst, adr, n);
+
+  /* FTF: NOR_FTHRES bytes or the rest of the transfer in the FIFO */
+  for (i = 0U; i < n; i++) {
+    while ((OCTOSPI1->SR & (OCTOSPI_SR_FTF | OCTOSPI_SR_TCF | OCTOSPI_SR_TEF)) == 0U);
+    buf[i] = *((__IO uint8_t *)&OCTOSPI1->DR);
+  }
+
+  return (NorComplete());
+}
+
+
+/*
+ *  Poll Status Register until (status & mask) == match
+ *    Parameter:      dopi:  0 - SPI, 1 - DTR OPI
+ *                    mask:  Status bits
+ *                    match: Expected value
+ *    Return Value:   BSP status
+ */
+
+static int32_t NorPoll (uint32_t dopi, uint32_t mask, uint32_t match) {
+  uint32_t sr;
+
+  while ((OCTOSPI1->SR & OCTOSPI_SR_BUSY) != 0U);
+
+  OCTOSPI1->PSMKR = mask;
+  OCTOSPI1->PSMAR = match;
+  OCTOSPI1->PIR   = MX25LM51245G_AUTOPOLLING_INTERVAL_TIME;
+  OCTOSPI1->CR    = (OCTOSPI1->CR & ~OCTOSPI_CR_PMM) | OCTOSPI_CR_APMS;   /* AND match, stop on match */
+
+  if (dopi != 0U) {
+    NorCommand(NOR_FMODE_POLL, NOR_DOPI_REG, DUMMY_CYCLES_REG_OCTAL_DTR,
+               MX25LM51245G_OCTA_READ_STATUS_REG_CMD, 0U, 2U);
+  } else {
+    NorCommand(NOR_FMODE_POLL, NOR_SPI_I | NOR_SPI_D, 0U,
+               MX25LM51245G_READ_STATUS_REG_CMD, 0U, 1U);
+  }
+
+  do {
+    sr = OCTOSPI1->SR;
+  } while ((sr & (OCTOSPI_SR_SMF | OCTOSPI_SR_TEF)) == 0U);
+  OCTOSPI1->FCR = OCTOSPI_FCR_CSMF | OCTOSPI_FCR_CTEF;
+
+  return (((sr & OCTOSPI_SR_TEF) != 0U) ? BSP_ERROR_PERIPH_FAILURE : BSP_ERROR_NONE);
+}
+
+
+/*
+ *  Write Enable (and wait for WEL)
+ *    Parameter:      dopi:  0 - SPI, 1 - DTR OPI
+ *    Return Value:   BSP status
+ */
+
+static int32_t NorWriteEnable (uint32_t dopi) {
+  int32_t rc;
+
+  if (dopi != 0U) {
+    rc = NorSend(NOR_DOPI_I, MX25LM51245G_OCTA_WRITE_ENABLE_CMD, 0U);
+  } else {
+    rc = NorSend(NOR_SPI_I,  MX25LM51245G_WRITE_ENABLE_CMD, 0U);
+  }
+  if (rc != BSP_ERROR_NONE) {
+    return (rc);
+  }
+
+  return (NorPoll(dopi, MX25LM51245G_SR_WEL, MX25LM51245G_SR_WEL));
+}
+
+
+/*
+ *  Read Register in DTR OPI mode
+ *    Parameter:      inst: Instruction
+ *                    adr:  Register Address
+ *                    reg:  Value (2 bytes)
+ *    Return Value:   BSP status
+ */
+
+static int32_t NorReadReg (uint32_t inst, uint32_t adr, uint8_t *reg) {
+  return (NorRead(NOR_DOPI_REG, DUMMY_CYCLES_REG_OCTAL_DTR, inst, adr, reg, 2U));
+}
+
+
+/*
+ *  Reset Memory (from SPI, STR OPI or DTR OPI mode to SPI mode)
+ *    Return Value:   BSP status
+ */
+
+static int32_t NorReset (void) {
+  uint32_t i;
+
+  for (i = 0U; i < NOR_RESET_NUM; i++) {
+    if (NorSend(NorResetSeq[i][0], NorResetSeq[i][1], 0U) != BSP_ERROR_NONE) {
+      return (BSP_ERROR_COMPONENT_FAILURE);
+    }
+  }
+
+  /* Wait in case the reset occurred during an erase */
+  HAL_Delay(MX25LM51245G_RESET_MAX_TIME);
+
+  return (BSP_ERROR_NONE);
+}
+
+
+/*
+ *  Enter DTR OPI mode from SPI mode
+ *    Return Value:   BSP status
+ */
+
+static int32_t NorEnterDOPI (void) {
+  uint8_t val[2];
+  uint8_t reg[2];
+
+  val[1] = 0U;
+
+  /* Dummy cycles (CR2 0x300), then DTR OPI (CR2 0x000) */
+  val[0] = MX25LM51245G_CR2_DC_6_CYCLES;
+  if ((NorWriteEnable(0U) != BSP_ERROR_NONE) ||
+      (NorWrite(NOR_SPI_I | NOR_SPI_A | NOR_SPI_D, MX25LM51245G_WRITE_CFG_REG2_CMD,
+                MX25LM51245G_CR2_REG3_ADDR, val, 1U) != BSP_ERROR_NONE)) {
+    return (BSP_ERROR_COMPONENT_FAILURE);
+  }
+  val[0] = MX25LM51245G_CR2_DOPI;
+  if ((NorWriteEnable(0U) != BSP_ERROR_NONE) ||
+      (NorWrite(NOR_SPI_I | NOR_SPI_A | NOR_SPI_D, MX25LM51245G_WRITE_CFG_REG2_CMD,
+                MX25LM51245G_CR2_REG1_ADDR, val, 1U) != BSP_ERROR_NONE)) {
+    return (BSP_ERROR_COMPONENT_FAILURE);
+  }
+
+  HAL_Delay(MX25LM51245G_WRITE_REG_MAX_TIME);
+
+  if ((NorPoll(1U, MX25LM51245G_SR_WIP, 0U) != BSP_ERROR_NONE) ||
+      (NorReadReg(MX25LM51245G_OCTA_READ_CFG_REG2_CMD, MX25LM51245G_CR2_REG1_ADDR, reg) != BSP_ERROR_NONE) ||
+      (reg[0] != MX25LM51245G_CR2_DOPI)) {
+    return (BSP_ERROR_COMPONENT_FAILURE);
+  }
+
+  return (BSP_ERROR_NONE);
+}
+
+
+/*
+ *  Initialize OCTOSPI1 and its Pins
+ *    Settings of the BSP for DTR: Macronix mode, delay hold quarter cycle
+ */
+
+static void NorOspiInit (void) {
+  uint32_t i;
+
+  OSPI_CLK_ENABLE();
+  OSPI_FORCE_RESET();
+  OSPI_RELEASE_RESET();
+
+  OSPI_CLK_GPIO_CLK_ENABLE();
+  OSPI_DQS_GPIO_CLK_ENABLE();
+  OSPI_CS_GPIO_CLK_ENABLE();
+  OSPI_D0_GPIO_CLK_ENABLE();
+  OSPI_D1_GPIO_CLK_ENABLE();
+  OSPI_D2_GPIO_CLK_ENABLE();
+  OSPI_D3_GPIO_CLK_ENABLE();
+  OSPI_D4_GPIO_CLK_ENABLE();
+  OSPI_D5_GPIO_CLK_ENABLE();
+  OSPI_D6_GPIO_CLK_ENABLE();
+  OSPI_D7_GPIO_CLK_ENABLE();
+
+  for (i = 0U; i < NOR_PIN_NUM; i++) {
+    NorPinInit(&NorPins[i]);
+  }
+  FLASH_TLM_PHASE(FLASH_TLM_PH_MSP);
+
+  OCTOSPI1->DCR1 = HAL_OSPI_MEMTYPE_MACRONIX |
+                   ((POSITION_VAL(MX25LM51245G_FLASH_SIZE) - 1U) << OCTOSPI_DCR1_DEVSIZE_Pos) |
+                   ((NOR_CSHT - 1U) << OCTOSPI_DCR1_CSHT_Pos);
+  OCTOSPI1->DCR2 = (BSP_OSPI_NOR_CLOCK_PRESCALER - 1U) << OCTOSPI_DCR2_PRESCALER_Pos;
+  OCTOSPI1->DCR3 = 0U;
+  OCTOSPI1->DCR4 = 0U;
+  OCTOSPI1->TCR  = HAL_OSPI_DHQC_ENABLE;
+  OCTOSPI1->CR   = ((NOR_FTHRES - 1U) << OCTOSPI_CR_FTHRES_Pos) | OCTOSPI_CR_EN;
+  FLASH_TLM_PHASE(FLASH_TLM_PH_OSPI);
+}
+
+
+/*
+ *  Initialize OSPI NOR (OPI DTR only)
+ *    Parameter:      Instance: OSPI instance
+ *                    Init:     Interface mode and transfer rate
+ *    Return Value:   BSP status
+ */
+
+int32_t BSP_OSPI_NOR_Init (uint32_t Instance, BSP_OSPI_NOR_Init_t *Init) {
+  OSPI_NOR_Ctx_t *ctx;
+  int32_t rc;
+
+  if (Instance >= OSPI_NOR_INSTANCES_NUMBER) {
+    return (BSP_ERROR_WRONG_PARAM);
+  }
+  if ((Init->InterfaceMode != BSP_OSPI_NOR_OPI_MODE) || (Init->TransferRate != BSP_OSPI_NOR_DTR_TRANSFER)) {
+    return (BSP_ERROR_FEATURE_NOT_SUPPORTED);
+  }
+  ctx = &Ospi_Nor_Ctx[Instance];
+  if (ctx->IsInitialized != OSPI_ACCESS_NONE) {
+    return (BSP_ERROR_NONE);
+  }
+
+  ctx->MemoryMapped.Ospi.SIOOMode          = HAL_OSPI_SIOO_INST_EVERY_CMD;
+  ctx->MemoryMapped.Ospi.DQSMode           = HAL_OSPI_DQS_ENABLE;
+  ctx->MemoryMapped.Ospi.TimeOutActivation = HAL_OSPI_TIMEOUT_COUNTER_DISABLE;
+  ctx->MemoryMapped.Ospi.TimeOutPeriod     = 0U;
+  ctx->MemoryMapped.CacheRemap             = BSP_OSPI_NOR_CACHE_REMAP_NONE;
+  ctx->MemoryMapped.CacheBurst             = BSP_OSPI_NOR_CACHE_BURST_INCR;
+  ctx->Sfdp.FlashSize                      = MX25LM51245G_FLASH_SIZE;
+  ctx->Sfdp.PageSize                       = MX25LM51245G_PAGE_SIZE;
+  ctx->ClockPrescaler                      = BSP_OSPI_NOR_CLOCK_PRESCALER;
+
+  NorOspiInit();
+
+  rc = NorReset();
+  FLASH_TLM_PHASE(FLASH_TLM_PH_RESET);
+  if (rc != BSP_ERROR_NONE) {
+    return (rc);
+  }
+  ctx->IsInitialized = OSPI_ACCESS_INDIRECT;
+  ctx->InterfaceMode = BSP_OSPI_NOR_SPI_MODE;
+  ctx->TransferRate  = BSP_OSPI_NOR_STR_TRANSFER;
+
+  rc = NorPoll(0U, MX25LM51245G_SR_WIP, 0U);
+  FLASH_TLM_PHASE(FLASH_TLM_PH_READY);
+  if (rc != BSP_ERROR_NONE) {
+    return (BSP_ERROR_COMPONENT_FAILURE);
+  }
+
+  rc = NorEnterDOPI();
+  FLASH_TLM_PHASE(FLASH_TLM_PH_CONFIG);
+  if (rc != BSP_ERROR_NONE) {
+    return (rc);
+  }
+  ctx->InterfaceMode = BSP_OSPI_NOR_OPI_MODE;
+  ctx->TransferRate  = BSP_OSPI_NOR_DTR_TRANSFER;
+
+  return (BSP_ERROR_NONE);
+}
+
+
+/*
+ *  De-Initialize OSPI NOR (memory stays in DTR OPI mode)
+ *    Parameter:      Instance: OSPI instance
+ *    Return Value:   BSP status
+ */
+
+int32_t BSP_OSPI_NOR_DeInit (uint32_t Instance) {
+  uint32_t i;
+
+  if (Instance >= OSPI_NOR_INSTANCES_NUMBER) {
+    return (BSP_ERROR_WRONG_PARAM);
+  }
+  if (Ospi_Nor_Ctx[Instance].IsInitialized == OSPI_ACCESS_NONE) {
+    return (BSP_ERROR_NONE);
+  }
+  if (Ospi_Nor_Ctx[Instance].IsInitialized == OSPI_ACCESS_MMP) {
+    if (BSP_OSPI_NOR_DisableMemoryMappedMode(Instance) != BSP_ERROR_NONE) {
+      return (BSP_ERROR_COMPONENT_FAILURE);
+    }
+  }
+
+  Ospi_Nor_Ctx[Instance].IsInitialized = OSPI_ACCESS_NONE;
+  Ospi_Nor_Ctx[Instance].InterfaceMode = BSP_OSPI_NOR_SPI_MODE;
+  Ospi_Nor_Ctx[Instance].TransferRate  = BSP_OSPI_NOR_STR_TRANSFER;
+
+  for (i = 0U; i < NOR_PIN_NUM; i++) {
+    NorPinDeInit(&NorPins[i]);
+  }
+  OSPI_FORCE_RESET();
+  OSPI_RELEASE_RESET();
+  OSPI_CLK_DISABLE();
+
+  return (BSP_ERROR_NONE);
+}
+
+
+/*
+ *  Program Data (page by page)
+ *    Parameter:      Instance:  OSPI instance
+ *                    pData:     Data
+ *                    WriteAddr: Memory Address
+ *                    Size:      Size (in bytes)
+ *    Return Value:   BSP status
+ */
+
+int32_t BSP_OSPI_NOR_Write (uint32_t Instance, uint8_t *pData, uint32_t WriteAddr, uint32_t Size) {
+  uint32_t n;
+
+  if (Instance >= OSPI_NOR_INSTANCES_NUMBER) {
+    return (BSP_ERROR_WRONG_PARAM);
+  }
+
+  while (Size != 0U) {
+    n = MX25LM51245G_PAGE_SIZE - (WriteAddr % MX25LM51245G_PAGE_SIZE);
+    if (n > Size) {
+      n = Size;
+    }
+    if ((NorPoll(1U, MX25LM51245G_SR_WIP, 0U) != BSP_ERROR_NONE) ||
+        (NorWriteEnable(1U) != BSP_ERROR_NONE) ||
+        (NorWrite(NOR_DOPI_I | NOR_DOPI_A | NOR_DOPI_D, MX25LM51245G_OCTA_PAGE_PROG_CMD,
+                  WriteAddr, pData, n) != BSP_ERROR_NONE) ||
+        (NorPoll(1U, MX25LM51245G_SR_WIP, 0U) != BSP_ERROR_NONE)) {
+      return (BSP_ERROR_COMPONENT_FAILURE);
+    }
+    WriteAddr += n;
+    pData     += n;
+    Size      -= n;
+  }
+
+  return (BSP_ERROR_NONE);
+}
+
+
+/*
+ *  Start Erase of Block
+ *    Parameter:      Instance:     OSPI instance
+ *                    BlockAddress: Block Address
+ *                    BlockSize:    4K, 64K or whole memory
+ *    Return Value:   BSP status
+ */
+
+int32_t BSP_OSPI_NOR_Erase_Block (uint32_t Instance, uint32_t BlockAddress, BSP_OSPI_NOR_Erase_t BlockSize) {
+  uint32_t inst;
+  uint32_t ccr;
+
+  if (Instance >= OSPI_NOR_INSTANCES_NUMBER) {
+    return (BSP_ERROR_WRONG_PARAM);
+  }
+
+  switch (BlockSize) {
+    case MX25LM51245G_ERASE_4K:
+      inst = MX25LM51245G_OCTA_SUBSECTOR_ERASE_4K_CMD;
+      ccr  = NOR_DOPI_I | NOR_DOPI_A;
+      break;
+    case MX25LM51245G_ERASE_64K:
+      inst = MX25LM51245G_OCTA_SECTOR_ERASE_64K_CMD;
+      ccr  = NOR_DOPI_I | NOR_DOPI_A;
+      break;
+    default:
+      inst = MX25LM51245G_OCTA_BULK_ERASE_CMD;
+      ccr  = NOR_DOPI_I;
+      break;
+  }
+
+  if ((NorPoll(1U, MX25LM51245G_SR_WIP, 0U) != BSP_ERROR_NONE) ||
+      (NorWriteEnable(1U) != BSP_ERROR_NONE) ||
+      (NorSend(ccr, inst, BlockAddress) != BSP_ERROR_NONE)) {
+    return (BSP_ERROR_COMPONENT_FAILURE);
+  }
+
+  return (BSP_ERROR_NONE);
+}
+
+
+/*
+ *  Start Erase of whole Memory
+ *    Parameter:      Instance: OSPI instance
+ *    Return Value:   BSP status
+ */
+
+int32_t BSP_OSPI_NOR_Erase_Chip (uint32_t Instance) {
+  return (BSP_OSPI_NOR_Erase_Block(Instance, 0U, MX25LM51245G_ERASE_BULK));
+}
+
+
+/*
+ *  Read Memory Status
+ *    Parameter:      Instance: OSPI instance
+ *    Return Value:   BSP_ERROR_NONE, BSP_ERROR_BUSY, BSP_ERROR_OSPI_SUSPENDED,
+ *                    BSP_ERROR_COMPONENT_FAILURE (P_FAIL/E_FAIL)
+ */
+
+int32_t BSP_OSPI_NOR_GetStatus (uint32_t Instance) {
+  uint8_t reg[2];
+
+  if (Instance >= OSPI_NOR_INSTANCES_NUMBER) {
+    return (BSP_ERROR_WRONG_PARAM);
+  }
+
+  if (NorReadReg(MX25LM51245G_OCTA_READ_SECURITY_REG_CMD, 0U, reg) != BSP_ERROR_NONE) {
+    return (BSP_ERROR_COMPONENT_FAILURE);
+  }
+  if ((reg[0] & (MX25LM51245G_SECR_P_FAIL | MX25LM51245G_SECR_E_FAIL)) != 0U) {
+    return (BSP_ERROR_COMPONENT_FAILURE);
+  }
+  if ((reg[0] & (MX25LM51245G_SECR_PSB | MX25LM51245G_SECR_ESB)) != 0U) {
+    return (BSP_ERROR_OSPI_SUSPENDED);
+  }
+
+  if (NorReadReg(MX25LM51245G_OCTA_READ_STATUS_REG_CMD, 0U, reg) != BSP_ERROR_NONE) {
+    return (BSP_ERROR_COMPONENT_FAILURE);
+  }
+
+  return (((reg[0] & MX25LM51245G_SR_WIP) != 0U) ? BSP_ERROR_BUSY : BSP_ERROR_NONE);
+}
+
+
+/*
+ *  Suspend Erase in progress
+ *    Parameter:      Instance: OSPI instance
+ *    Return Value:   BSP status
+ */
+
+int32_t BSP_OSPI_NOR_SuspendErase (uint32_t Instance) {
+
+  if (Instance >= OSPI_NOR_INSTANCES_NUMBER) {
+    return (BSP_ERROR_WRONG_PARAM);
+  }
+
+  if ((BSP_OSPI_NOR_GetStatus(Instance) != BSP_ERROR_BUSY) ||
+      (NorSend(NOR_DOPI_I, MX25LM51245G_OCTA_PROG_ERASE_SUSPEND_CMD, 0U) != BSP_ERROR_NONE) ||
+      (BSP_OSPI_NOR_GetStatus(Instance) != BSP_ERROR_OSPI_SUSPENDED)) {
+    return (BSP_ERROR_COMPONENT_FAILURE);
+  }
+
+  return (BSP_ERROR_NONE);
+}
+
+
+/*
+ *  Resume suspended Erase
+ *    Parameter:      Instance: OSPI instance
+ *    Return Value:   BSP status
+ */
+
+int32_t BSP_OSPI_NOR_ResumeErase (uint32_t Instance) {
+
+  if (Instance >= OSPI_NOR_INSTANCES_NUMBER) {
+    return (BSP_ERROR_WRONG_PARAM);
+  }
+
+  if ((BSP_OSPI_NOR_GetStatus(Instance) != BSP_ERROR_OSPI_SUSPENDED) ||
+      (NorSend(NOR_DOPI_I, MX25LM51245G_OCTA_PROG_ERASE_RESUME_CMD, 0U) != BSP_ERROR_NONE) ||
+      (BSP_OSPI_NOR_GetStatus(Instance) != BSP_ERROR_BUSY)) {
+    return (BSP_ERROR_COMPONENT_FAILURE);
+  }
+
+  return (BSP_ERROR_NONE);
+}
+
+
+/*
+ *  Read Memory ID (Manufacturer ID, Memory type, Memory density)
+ *    Parameter:      Instance: OSPI instance
+ *                    Id:       ID (3 bytes)
+ *    Return Value:   BSP status
+ */
+
+int32_t BSP_OSPI_NOR_ReadID (uint32_t Instance, uint8_t *Id) {
+
+  if (Instance >= OSPI_NOR_INSTANCES_NUMBER) {
+    return (BSP_ERROR_WRONG_PARAM);
+  }
+
+  if (NorRead(NOR_DOPI_REG, DUMMY_CYCLES_REG_OCTAL_DTR, MX25LM51245G_OCTA_READ_ID_CMD, 0U, Id, 3U) != BSP_ERROR_NONE) {
+    return (BSP_ERROR_COMPONENT_FAILURE);
+  }
+
+  return (BSP_ERROR_NONE);
+}
+
+
+/*
+ *  Enter Memory-mapped Mode (read at OCTOSPI1_BASE)
+ *    Parameter:      Instance: OSPI instance
+ *    Return Value:   BSP status
+ */
+
+int32_t BSP_OSPI_NOR_EnableMemoryMappedMode (uint32_t Instance) {
+  MX25LM51245G_MemoryMapped_t *cfg;
+
+  if (Instance >= OSPI_NOR_INSTANCES_NUMBER) {
+    return (BSP_ERROR_WRONG_PARAM);
+  }
+  cfg = &Ospi_Nor_Ctx[Instance].MemoryMapped.Ospi;
+
+  while ((OCTOSPI1->SR & OCTOSPI_SR_BUSY) != 0U);
+
+  OCTOSPI1->TCR  = (OCTOSPI1->TCR & ~OCTOSPI_TCR_DCYC) | DUMMY_CYCLES_READ_OCTAL_DTR;
+  OCTOSPI1->CCR  = NOR_DOPI_I | NOR_DOPI_A | NOR_DOPI_D | cfg->DQSMode | cfg->SIOOMode;
+  OCTOSPI1->IR   = MX25LM51245G_OCTA_READ_DTR_CMD;
+  OCTOSPI1->WTCR = 0U;
+  OCTOSPI1->WCCR = NOR_DOPI_I | NOR_DOPI_A | NOR_DOPI_D;
+  OCTOSPI1->WIR  = MX25LM51245G_OCTA_PAGE_PROG_CMD;
+  if (cfg->TimeOutActivation == HAL_OSPI_TIMEOUT_COUNTER_ENABLE) {
+    OCTOSPI1->LPTR = cfg->TimeOutPeriod;
+  }
+  OCTOSPI1->CR   = (OCTOSPI1->CR & ~(OCTOSPI_CR_FMODE | OCTOSPI_CR_TCEN)) |
+                   cfg->TimeOutActivation | NOR_FMODE_MMP;
+
+  Ospi_Nor_Ctx[Instance].IsInitialized = OSPI_ACCESS_MMP;
+
+  return (BSP_ERROR_NONE);
+}
+
+
+/*
+ *  Leave Memory-mapped Mode
+ *    Parameter:      Instance: OSPI instance
+ *    Return Value:   BSP status
+ */
+
+int32_t BSP_OSPI_NOR_DisableMemoryMappedMode (uint32_t Instance) {
+
+  if (Instance >= OSPI_NOR_INSTANCES_NUMBER) {
+    return (BSP_ERROR_WRONG_PARAM);
+  }
+  if (Ospi_Nor_Ctx[Instance].IsInitialized != OSPI_ACCESS_MMP) {
+    return (BSP_ERROR_OSPI_MMP_UNLOCK_FAILURE);
+  }
+
+  OCTOSPI1->CR |= OCTOSPI_CR_ABORT;
+  while ((OCTOSPI1->CR & OCTOSPI_CR_ABORT) != 0U);
+  while ((OCTOSPI1->SR & OCTOSPI_SR_BUSY)  != 0U);
+  OCTOSPI1->FCR = OCTOSPI_FCR_CTCF;
+  OCTOSPI1->CR &= ~OCTOSPI_CR_FMODE;
+
+  Ospi_Nor_Ctx[Instance].IsInitialized = OSPI_ACCESS_INDIRECT;
+
+  return (BSP_ERROR_NONE);
+}
+
+
+/*
+ *  Set Memory-mapped Configuration (no ICACHE remap)
+ *    Parameter:      Instance: OSPI instance
+ *                    Cfg:      Configuration
+ *    Return Value:   BSP status
+ */
+
+int32_t BSP_OSPI_NOR_ConfigMemoryMappedMode (uint32_t Instance, BSP_OSPI_NOR_MemoryMapped_t *Cfg) {
+
+  if (Instance >= OSPI_NOR_INSTANCES_NUMBER) {
+    return (BSP_ERROR_WRONG_PARAM);
+  }
+  if (Ospi_Nor_Ctx[Instance].IsInitialized == OSPI_ACCESS_MMP) {
+    return (BSP_ERROR_BUSY);
+  }
+  if (Cfg->CacheRemap != BSP_OSPI_NOR_CACHE_REMAP_NONE) {
+    return (BSP_ERROR_FEATURE_NOT_SUPPORTED);
+  }
+
+  Ospi_Nor_Ctx[Instance].MemoryMapped = *Cfg;
+
+  return (BSP_ERROR_NONE);
+}
+
+
+/*
+ *  Configure Memory Interface (OPI DTR only)
+ *    Parameter:      Instance: OSPI instance
+ *                    Mode:     Interface mode
+ *                    Rate:     Transfer rate
+ *    Return Value:   BSP status
+ */
+
+int32_t BSP_OSPI_NOR_ConfigFlash (uint32_t Instance, BSP_OSPI_NOR_Interface_t Mode, BSP_OSPI_NOR_Transfer_t Rate) {
+
+  if (Instance >= OSPI_NOR_INSTANCES_NUMBER) {
+    return (BSP_ERROR_WRONG_PARAM);
+  }
+  if (Ospi_Nor_Ctx[Instance].IsInitialized == OSPI_ACCESS_MMP) {
+    return (BSP_ERROR_OSPI_MMP_LOCK_FAILURE);
+  }
+  if ((Mode != BSP_OSPI_NOR_OPI_MODE) || (Rate != BSP_OSPI_NOR_DTR_TRANSFER)) {
+    return (BSP_ERROR_FEATURE_NOT_SUPPORTED);
+  }
+
+  return (BSP_ERROR_NONE);
+}
@@ -0,0 +1,176 @@
+/* -----------------------------------------------------------------------------
+ * Copyright (c) 2026 ARM Ltd.
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software. Permission is granted to anyone to use this
+ * software for any purpose, including commercial applications, and to alter
+ * it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V1.00
+ *
+ * Project:      OCTOSPI transaction recorder (optional)
+ * --------------------------------------------------------------------------- */
+
+/* History:
+ *  Version 1.00
+ *    Initial release
+ */
+
+/* The recorder is compiled in with OSPI_TRACE defined. FlashPrg.c then
+ * logs every HAL_OSPI_Command, Transmit, Receive, AutoPolling and
+ * MemoryMapped call into the OspiTrace ring in PrgData. The calls are
+ * redirected by armlink to $Sub$$ wrappers, the HAL OSPI driver itself is
+ * not modified. The ring survives
+ * Init/UnInit and holds the last OSPI_TRACE_NUM records of the session; the
+ * host locates it by its symbol in the FLM and reads it after the session.
+ * Times are DWT_CYCCNT values.
+ */
+
+#ifndef OSPI_TRACE_H
+#define OSPI_TRACE_H
+
+#include <stdint.h>
+
+#define OSPI_TRACE_MAGIC       0x4F535452  // "OSTR", ring is valid
+
+#ifndef OSPI_TRACE_NUM
+#define OSPI_TRACE_NUM         32          // Records in ring, power of 2
+#endif
+
+// Record types
+#define OSPI_TRACE_REC_CMD     1           // HAL_OSPI_Command
+#define OSPI_TRACE_REC_TX      2           // HAL_OSPI_Transmit
+#define OSPI_TRACE_REC_RX      3           // HAL_OSPI_Receive
+#define OSPI_TRACE_REC_POLL    4           // HAL_OSPI_AutoPolling
+#define OSPI_TRACE_REC_MMP     5           // HAL_OSPI_MemoryMapped
+
+/* Record fields by type:
+ *  CMD:     ccr    = instruction, address, data phase and DTR/DQS/SIOO bits
+ *                    in OCTOSPI_CCR layout
+ *           opcode = instruction, address = address, length = data bytes,
+ *           dummy  = dummy cycles
+ *  TX/RX:   address = OCTOSPI_AR, length = bytes transferred
+ *  POLL:    address = match value, length = polling interval in clock cycles
+ *           (polling iterations = cycles / (interval * OSPI clock divider))
+ *  MMP:     ccr = timeout activation, length = timeout period
+ */
+typedef struct {
+  uint32_t time;                           // Cycle count at call entry
+  uint32_t cycles;                         // Duration of the call
+  uint32_t address;
+  uint32_t length;
+  uint32_t ccr;
+  uint16_t opcode;
+  uint8_t  dummy;
+  uint8_t  type;                           // bits 0..3: record type, bits 4..7: HAL status
+} OspiTraceRec_t;
+
+typedef struct {
+  uint32_t       magic;                    // OSPI_TRACE_MAGIC
+  uint32_t       num;                      // OSPI_TRACE_NUM
+  uint32_t       count;                    // Records written, next is rec[count % num]
+  uint32_t       tEnter;                   // Cycle count at entry of current call
+  OspiTraceRec_t rec[OSPI_TRACE_NUM];
+} OspiTrace_t;
+
+#if defined OSPI_TRACE
+
+#define OSPI_TRACE_DEMCR       (*((volatile uint32_t *)0xE000EDFC))
+#define OSPI_TRACE_DWT_CTRL    (*((volatile uint32_t *)0xE0001000))
+#define OSPI_TRACE_DWT_CYCCNT  (*((volatile uint32_t *)0xE0001004))
+
+extern OspiTrace_t OspiTrace;
+
+static __inline void OspiTraceInit (void) {
+  uint32_t *p;
+  uint32_t  n;
+
+  if (OspiTrace.magic != OSPI_TRACE_MAGIC) {
+    /* no scatter loader: PrgData content is undefined after download */
+    p = (uint32_t *)&OspiTrace;
+    for (n = 0U; n < (sizeof(OspiTrace) / 4U); n++) {
+      p[n] = 0U;
+    }
+    OspiTrace.magic = OSPI_TRACE_MAGIC;
+    OspiTrace.num   = OSPI_TRACE_NUM;
+  }
+
+  OSPI_TRACE_DEMCR    |= (1UL << 24);      // TRCENA
+  OSPI_TRACE_DWT_CTRL |=  1UL;             // CYCCNTENA
+}
+
+static __inline OspiTraceRec_t *OspiTraceRec (uint32_t type, uint32_t status) {
+  OspiTraceRec_t *r = &OspiTrace.rec[OspiTrace.count & (OSPI_TRACE_NUM - 1U)];
+
+  OspiTrace.count++;
+  r->time    = OspiTrace.tEnter;
+  r->cycles  = OSPI_TRACE_DWT_CYCCNT - OspiTrace.tEnter;
+  r->address = 0U;
+  r->length  = 0U;
+  r->ccr     = 0U;
+  r->opcode  = 0U;
+  r->dummy   = 0U;
+  r->type    = (uint8_t)(type | (status << 4));
+  return (r);
+}
+
+static __inline void OspiTraceCmd (OSPI_RegularCmdTypeDef *cmd, uint32_t status) {
+  OspiTraceRec_t *r = OspiTraceRec(OSPI_TRACE_REC_CMD, status);
+
+  r->ccr     = cmd->InstructionMode | cmd->InstructionSize | cmd->InstructionDtrMode |
+               cmd->AddressMode     | cmd->AddressSize     | cmd->AddressDtrMode     |
+               cmd->DataMode        | cmd->DataDtrMode     | cmd->DQSMode            |
+               cmd->SIOOMode;
+  r->opcode  = (uint16_t)cmd->Instruction;
+  r->address = cmd->Address;
+  r->length  = cmd->NbData;
+  r->dummy   = (uint8_t)cmd->DummyCycles;
+}
+
+static __inline void OspiTraceXfer (OSPI_HandleTypeDef *hospi, uint32_t type, uint32_t status) {
+  OspiTraceRec_t *r = OspiTraceRec(type, status);
+
+  r->address = hospi->Instance->AR;
+  r->length  = hospi->XferSize;
+}
+
+static __inline void OspiTracePoll (OSPI_AutoPollingTypeDef *cfg, uint32_t status) {
+  OspiTraceRec_t *r = OspiTraceRec(OSPI_TRACE_REC_POLL, status);
+
+  r->address = cfg->Match;
+  r->length  = cfg->Interval;
+}
+
+static __inline void OspiTraceMmp (OSPI_MemoryMappedTypeDef *cfg, uint32_t status) {
+  OspiTraceRec_t *r = OspiTraceRec(OSPI_TRACE_REC_MMP, status);
+
+  r->ccr     = cfg->TimeOutActivation;
+  r->length  = cfg->TimeOutPeriod;
+}
+
+static __inline void OspiTraceEnter (void) {
+  OspiTrace.tEnter = OSPI_TRACE_DWT_CYCCNT;
+}
+
+#define OSPI_TRACE_INIT()                     OspiTraceInit()
+
+#else
+
+#define OSPI_TRACE_INIT()
+
+#endif /* OSPI_TRACE */
+
+#endif /* OSPI_TRACE_H */
@@ -18,13 +18,15 @@
  * 3. This notice may not be removed or altered from any source distribution.
  *
  *
- * $Date:        27. February 2020
- * $Revision:    V1.2.0
+ * $Date:        18. October 2026
+ * $Revision:    V1.3.0
  *
  * Project:      Flash Device Description for ST STM32L5xx Flash
  * --------------------------------------------------------------------------- */
 
 /* History:
+ *  Version 1.3.0
+ *    Added combined non-secure/secure Algorithm
  *  Version 1.2.0
  *    Added OPT Algorithms
  *  Version 1.1.0
@@ -78,6 +80,31 @@ extern struct FlashDevice const FlashDevice;
   };
 #endif
 
+
+/* One device for both aliases, so an image using both gets one Init:
+   pdsc entry start="0x08000000" size="0x04080000". Registers and page
+   security are selected from the alias of each address. */
+#ifdef STM32L5xx_512_0x08_0x0C
+  struct FlashDevice const FlashDevice  =  {
+    FLASH_DRV_VERS,                /* Driver Version, do not modify! */
+    "STM32L5x_512_NS_S_Flash",     /* Device Name (512kB, both aliases) */
+    ONCHIP,                        /* Device Type */
+    0x08000000,                    /* Device Start Address */
+    0x04080000,                    /* Device Size in Bytes (up to end of secure alias) */
+    1024,                          /* Programming Page Size */
+    0,                             /* Reserved, must be 0 */
+    0xFF,                          /* Initial Content of Erased Memory */
+    400,                           /* Program Page Timeout 400 mSec */
+    400,                           /* Erase Sector Timeout 400 mSec */
+
+    /* Specify Size and Address of Sectors */
+    0x0000800, 0x0000000,          /* Sector Size  2kB (256 Sectors), non-secure alias */
+    0x3F80000, 0x0080000,          /* Gap between the aliases, no Flash present */
+    0x0000800, 0x4000000,          /* Sector Size  2kB (256 Sectors), secure alias */
+    SECTOR_END
+  };
+#endif
+
 #endif /* FLASH_MEM */
 
 
@@ -18,13 +18,23 @@
  * 3. This notice may not be removed or altered from any source distribution.
  *
  *
- * $Date:        27. February 2020
- * $Revision:    V1.2.0
+ * $Date:        18. October 2026
+ * $Revision:    V1.3.0
  *
  * Project:      Flash Programming Functions for ST STM32L5xx Flash
  * --------------------------------------------------------------------------- */
 
 /* History:
+ *  Version 1.3.0
+ *    Added combined non-secure/secure Algorithm
+ *    Corrected bank selection for secure alias in Dual-Bank mode
+ *    Flash geometry is resolved once in Init
+ *    Added asynchronous erase functions
+ *    Option byte masks are named
+ *    Added optional telemetry (FLASH_TELEMETRY)
+ *    Added optional ITM events (FLASH_TELEMETRY_ITM)
+ *    Added optional Verify and BlankCheck for Flash memory (FLASH_VERIFY,
+ *    FlashCompare.h), enabled for the combined Algorithm only
  *  Version 1.2.0
  *    Algorithm rework.
  *    Added OPT Algorithms
@@ -36,6 +46,9 @@
  */
 
 #include "..\FlashOS.h"        /* FlashOS Structures */
+#include "..\FlashOSExt.h"     /* Asynchronous Functions, Digest */
+#include "..\FlashTelemetry.h" /* optional Telemetry */
+#include "..\FlashCompare.h"   /* Compare and Blank Check */
 
 typedef volatile unsigned long    vu32;
 typedef          unsigned long     u32;
@@ -47,6 +60,9 @@ typedef          unsigned long     u32;
 #define DBGMCU_BASE      (0xE0044000)
 #define FLASHSIZE_BASE   (0x0BFA05E0)
 
+#define FLASH_NS_MSK     (0x08FFFFFF)   /* maps secure alias 0x0C000000 to 0x08000000 */
+#define FLASH_S_OFS      (0x04000000)   /* offset of secure alias */
+
 #define FLASH           ((FLASH_TypeDef  *) FLASH_BASE)
 #define DBGMCU          ((DBGMCU_TypeDef *) DBGMCU_BASE)
 
@@ -138,19 +154,51 @@ typedef struct
 #define FLASH_OPTR_DBANK        ((u32)(  1U << 22))
 #define FLASH_OPTR_TZEN         ((u32)(  1U << 31))
 
+// Flash option byte masks (implemented bits)
+#define FLASH_OPTR_MSK          ((u32)(0x9F7F77FF))     /* OPTR */
+#define FLASH_NSBOOTADD_MSK     ((u32)(0xFFFFFF80))     /* NSBOOTADDxR: NSBOOTADDx */
+#define FLASH_SECBOOTADD_MSK    ((u32)(0xFFFFFF83))     /* SECBOOTADD0R: SECBOOTADD0, BOOT_LOCK */
+#define FLASH_WRP_MSK           ((u32)(0x007F007F))     /* WRPxyR: start/end page */
+#define FLASH_SECWMR1_MSK       ((u32)(0x007F007F))     /* SECWMxR1: start/end page */
+#define FLASH_SECWMR2_MSK       ((u32)(0x807F0000))     /* SECWMxR2: HDP end page, HDPxEN */
+
 
 
 #define FLASH_PGERR             (FLASH_SR_OPERR  | FLASH_SR_PROGERR | FLASH_SR_WRPERR  | \
                                  FLASH_SR_PGAERR | FLASH_SR_SIZERR  | FLASH_SR_PGSERR  | FLASH_SR_OPTWERR)
 
 #if defined FLASH_MEM
+// Asynchronous Operation
+#define FLASH_OP_NONE            0U     /* no operation started */
+#define FLASH_OP_ERASE           1U     /* page or mass erase started */
+#define FLASH_OP_MASS_S          2U     /* secure mass erase started, non-secure one follows */
+
+// Flash Geometry (resolved in Init)
+typedef struct
+{
+  u32   ofsMsk;         /* Mask of the address offset inside a bank */
+  u32   bnkMsk;         /* Address bit selecting bank 2 (0 in Single-Bank mode) */
+  u32   pgShift;        /* Page size as power of two (11 = 2K, 12 = 4K) */
+#if defined STM32L5xx_512_0x08_0x0C
+  u32   secMsk;         /* 1 if the secure alias uses the secure registers (TZEN) */
+  vu32 *pCR[2];         /* Control register for non-secure, secure alias */
+  vu32 *pSR[2];         /* Status register for non-secure, secure alias */
+#endif
+} FLASH_GeoTypeDef;
+
 static u32 gFlashBase;                  /* Flash base address */
 static u32 gFlashSize;                  /* Flash size in bytes */
+static FLASH_GeoTypeDef gFlashGeo;      /* Flash geometry */
+static u32 gFlashOp;                    /* Started asynchronous operation */
 
 static vu32 *pFlashCR;                  /* Pointer to Flash Control register */
 static vu32 *pFlashSR;                  /* Pointer to Flash Status register */
 #endif /* FLASH_MEM */
 
+#if defined FLASH_TELEMETRY
+FlashTelemetry_t FlashTelemetry;        /* read by the host via its FLM symbol */
+#endif /* FLASH_TELEMETRY */
+
 static void DSB(void) {
     __asm("DSB");
 }
@@ -213,15 +261,14 @@ static u32 GetFlashBankMode (void) {
 
 
 /*
- * Get Flash Bank Number
- *    Parameter:      adr:  Sector Address
- *    Return Value:   Bank Number (0..1)
- *                    Flash bank size is always the half of the Flash size
+ * Init Flash Geometry
+ *    Bank and page layout is read once, sector functions use shift/mask only
  */
 
 #if defined FLASH_MEM
-static u32 GetFlashBankNum(u32 adr) {
-  u32 flashBankNum;
+static void InitFlashGeometry (void) {
+
+  gFlashSize = (M32(FLASHSIZE_BASE) & 0x0000FFFF) << 10;
 
   if (GetFlashType() == 1U)
   {
@@ -229,28 +276,48 @@ static u32 GetFlashBankNum(u32 adr) {
     if (GetFlashBankMode() == 1U)
     {
       /* Dual-Bank Flash configured as Dual-Bank */
-      if (adr >= (gFlashBase + (gFlashSize >> 1)))
-      {
-        flashBankNum = 1U;
-      }
-      else
-      {
-        flashBankNum = 0U;
-      }
+      gFlashGeo.ofsMsk  = (gFlashSize >> 1) - 1U;
+      gFlashGeo.bnkMsk  = (gFlashSize >> 1);             /* bank size is half of the Flash size */
+      gFlashGeo.pgShift = 11U;                           /* 2K sector size */
     }
     else
     {
       /* Dual-Bank Flash configured as Single-Bank */
-      flashBankNum = 0U;
+      gFlashGeo.ofsMsk  =  gFlashSize - 1U;
+      gFlashGeo.bnkMsk  =  0U;
+      gFlashGeo.pgShift = 12U;                           /* 4K sector size */
     }
   }
   else
   {
     /* Single-Bank Flash */
-    flashBankNum = 0U;
+    gFlashGeo.ofsMsk  =  gFlashSize - 1U;
+    gFlashGeo.bnkMsk  =  0U;
+    gFlashGeo.pgShift = 11U;                             /* 2K sector size */
   }
 
-  return (flashBankNum);
+#if defined STM32L5xx_512_0x08_0x0C
+  gFlashGeo.secMsk  = GetFlashSecureMode();
+  gFlashGeo.pCR[0]  = &FLASH->NSCR;
+  gFlashGeo.pSR[0]  = &FLASH->NSSR;
+  gFlashGeo.pCR[1]  = &FLASH->SECCR;
+  gFlashGeo.pSR[1]  = &FLASH->SECSR;
+#endif /* STM32L5xx_512_0x08_0x0C */
+}
+#endif /* FLASH_MEM */
+
+
+/*
+ * Get Flash Bank Number
+ *    Parameter:      adr:  Sector Address
+ *    Return Value:   Bank Number (0..1)
+ *                    Flash bank size is always the half of the Flash size
+ */
+
+#if defined FLASH_MEM
+static u32 GetFlashBankNum(u32 adr) {
+
+  return (((adr & gFlashGeo.bnkMsk) != 0U) ? 1U : 0U);
 }
 #endif /* FLASH_MEM */
 
@@ -263,29 +330,110 @@ static u32 GetFlashBankNum(u32 adr) {
 
 #if defined FLASH_MEM
 static u32 GetFlashPageNum (unsigned long adr) {
-  u32 flashPageNum;
 
-  if (GetFlashType() == 1U)
-  {
-    /* Dual-Bank Flash */
-    if (GetFlashBankMode() == 1U)
-    {
-      /* Dual-Bank Flash configured as Dual-Bank */
-      flashPageNum = (((adr & ((gFlashSize >> 1) - 1U)) ) >> 11); /* 2K sector size */
-    }
-    else
-    {
-      /* Dual-Bank Flash configured as Single-Bank */
-      flashPageNum = (((adr & (gFlashSize        - 1U)) ) >> 12); /* 4K sector size */
-    }
+  return ((adr & gFlashGeo.ofsMsk) >> gFlashGeo.pgShift);
+}
+#endif /* FLASH_MEM */
+
+
+/*
+ * Select Flash Control, Status register
+ *    Parameter:      adr:  Address in non-secure or secure alias
+ *    Return Value:   0 = non-secure registers
+ *                    1 = secure registers
+ */
+
+#if defined STM32L5xx_512_0x08_0x0C
+static u32 SelectFlashRegs (u32 adr) {
+  u32 secure;
+
+  secure   = (adr >> 26) & gFlashGeo.secMsk;             /* FLASH_S_OFS selects the secure alias */
+  pFlashCR = gFlashGeo.pCR[secure];
+  pFlashSR = gFlashGeo.pSR[secure];
+
+  return (secure);
+}
+#endif /* STM32L5xx_512_0x08_0x0C */
+
+
+/*
+ * Check for the Gap between the Aliases
+ *    Parameter:      adr:  Address in the device range
+ *    Return Value:   0 = Flash in non-secure or secure alias
+ *                    1 = no Flash present
+ */
+
+#if defined STM32L5xx_512_0x08_0x0C
+static u32 IsFlashGap (u32 adr) {
+  u32 ofs;
+
+  ofs = adr - gFlashBase;
+
+  return (((ofs >= gFlashSize) && ((ofs - FLASH_S_OFS) >= gFlashSize)) ? 1U : 0U);
+}
+#endif /* STM32L5xx_512_0x08_0x0C */
+
+
+/*
+ * Set Flash Page Security
+ *    Parameter:      b:      Bank Number (0..1)
+ *                    p:      Page Number (0..127)
+ *                    secure: 0 = non-secure, 1 = secure
+ *    Page is made secure/non-secure in FLASH_SECBBxy to match the used alias,
+ *    it keeps this security after the operation (as the 0x0C00 algorithm)
+ */
+
+#if defined STM32L5xx_512_0x08_0x0C
+static void SetFlashPageSecurity (u32 b, u32 p, u32 secure) {
+  vu32 *pSecBB;
+  u32   msk;
+
+  if (gFlashGeo.secMsk == 0U) {
+    return;                                              /* no block-based security without TZEN */
   }
-  else
-  {
-    /* Single-Bank Flash */
-        flashPageNum = (((adr & (gFlashSize      - 1U)) ) >> 11); /* 2K sector size */
+
+  pSecBB = (b == 0U) ? &FLASH->SECBBA0 : &FLASH->SECBBB0;
+  pSecBB += (p >> 5);
+  msk     = 1U << (p & 0x1FU);
+
+  if (secure == 1U) {
+    *pSecBB |=  msk;
+  } else {
+    *pSecBB &= ~msk;
   }
+  DSB();
+}
+#endif /* STM32L5xx_512_0x08_0x0C */
+
+
+/*
+ *  Start Mass Erase of both Banks via the selected registers
+ */
+
+#if defined FLASH_MEM
+static void StartMassErase (void) {
 
-  return (flashPageNum);
+  *pFlashSR  = FLASH_PGERR;                              /* Reset Error Flags */
+
+  *pFlashCR  = (FLASH_CR_MER1 | FLASH_CR_MER2);          /* Bank A/B mass erase enabled */
+  *pFlashCR |=  FLASH_CR_STRT;                           /* Start erase */
+  DSB();
+}
+#endif /* FLASH_MEM */
+
+
+/*
+ *  Wait until a started Operation is finished
+ *    Return Value:   OP_DONE, OP_ERROR
+ */
+
+#if defined FLASH_MEM
+static int WaitOperation (void) {
+  int rc;
+
+  FLASH_TLM_SPIN((rc = PollOperation()) == OP_BUSY);
+
+  return (rc);
 }
 #endif /* FLASH_MEM */
 
@@ -338,7 +486,38 @@ int Init (unsigned long adr, unsigned long clk, unsigned long fnc)
   (void)clk;
   (void)fnc;
 
+  FLASH_TLM_BEGIN(FLASH_TLM_INIT, adr, 0);
+
 #if defined FLASH_MEM
+  InitFlashGeometry();
+  gFlashOp = FLASH_OP_NONE;
+
+#if defined STM32L5xx_512_0x08_0x0C
+  /* Both aliases are served by one Init, registers are selected per address */
+
+  if (FLASH->NSCR & FLASH_CR_LOCK)
+  {
+    /* unlock FLASH_NSCR */
+    FLASH->NSKEYR = FLASH_KEY1;
+    FLASH->NSKEYR = FLASH_KEY2;
+    DSB();
+  }
+  while (FLASH->NSSR & FLASH_SR_BSY);                    /* Wait until operation is finished */
+
+  if (gFlashGeo.secMsk == 1U)
+  {
+    if (FLASH->SECCR & FLASH_CR_LOCK)
+    {
+      /* unlock FLASH_SECCR */
+      FLASH->SECKEYR = FLASH_KEY1;
+      FLASH->SECKEYR = FLASH_KEY2;
+      DSB();
+    }
+    while (FLASH->SECSR & FLASH_SR_BSY);                 /* Wait until operation is finished */
+  }
+
+  SelectFlashRegs(adr);
+#else
   if (GetFlashSecureMode() == 0U)
   {                                                      /* Flash non-secure */
     /* set used Control, Status register */
@@ -369,7 +548,7 @@ int Init (unsigned long adr, unsigned long clk, unsigned long fnc)
     FLASH->SECBBA2 = 0xFFFFFFFF;
     FLASH->SECBBA3 = 0xFFFFFFFF;
 
-    if (GetFlashBankMode() == 1U)                        /* Flash secure DUAL BANK */
+    if (gFlashGeo.bnkMsk != 0U)                          /* Flash secure DUAL BANK */
     {
       /* Flash block-based secure bank2 */
       FLASH->SECBBB0 = 0xFFFFFFFF;
@@ -378,11 +557,11 @@ int Init (unsigned long adr, unsigned long clk, unsigned long fnc)
       FLASH->SECBBB3 = 0xFFFFFFFF;
     }
   }
+#endif /* STM32L5xx_512_0x08_0x0C */
 
   while (*pFlashSR & FLASH_SR_BSY);                      /* Wait until operation is finished */
 
-  gFlashBase = adr;
-  gFlashSize = (M32(FLASHSIZE_BASE) & 0x0000FFFF) << 10;
+  gFlashBase = adr & FLASH_NS_MSK;                       /* Sector addresses are mapped to 0x08000000 */
 #endif /* FLASH_MEM */
 
 #if defined FLASH_OPT
@@ -406,7 +585,7 @@ int Init (unsigned long adr, unsigned long clk, unsigned long fnc)
 //while (FLASH->NSCR & FLASH_CR_OBL_LAUNCH);             /* Wait until option bytes are updated */
 #endif /* FLASH_OPT */
 
-  return (0);
+  return (FLASH_TLM_RET(FLASH_TLM_INIT, 0));
 }
 
 
@@ -420,7 +599,23 @@ int UnInit (unsigned long fnc)
 {
   (void)fnc;
 
+  FLASH_TLM_BEGIN(FLASH_TLM_UNINIT, 0, 0);
+
 #if defined FLASH_MEM
+  (void)WaitOperation();                                 /* finish a started erase */
+
+#if defined STM32L5xx_512_0x08_0x0C
+  if (gFlashGeo.secMsk == 1U)
+  {
+    /* Lock secure Flash operation */
+    FLASH->SECCR = FLASH_CR_LOCK;
+    DSB();
+    while (FLASH->SECSR & FLASH_SR_BSY);                 /* Wait until operation is finished */
+  }
+
+  SelectFlashRegs(gFlashBase);                           /* non-secure registers */
+#endif /* STM32L5xx_512_0x08_0x0C */
+
   /* Lock Flash operation */
   *pFlashCR = FLASH_CR_LOCK;
   DSB();
@@ -444,7 +639,7 @@ int UnInit (unsigned long fnc)
   while (FLASH->NSCR & FLASH_SR_BSY);                    /* Wait until operation is finished */
 #endif /* FLASH_OPT */
 
-  return (0);
+  return (FLASH_TLM_RET(FLASH_TLM_UNINIT, 0));
 }
 
 
@@ -456,6 +651,27 @@ int UnInit (unsigned long fnc)
  *    Return Value:   0 - OK,  1 - Failed
  */
 
+#if defined FLASH_MEM && defined FLASH_VERIFY
+int BlankCheck (unsigned long adr, unsigned long sz, unsigned char pat) {
+  int rc;
+
+  FLASH_TLM_BEGIN(FLASH_TLM_BLANKCHECK, adr, sz);
+
+  if (WaitOperation() != OP_DONE) {
+    return (FLASH_TLM_RET(FLASH_TLM_BLANKCHECK, 1));     /* started erase failed */
+  }
+#if defined STM32L5xx_512_0x08_0x0C
+  if (IsFlashGap(adr) == 1U) {
+    return (FLASH_TLM_RET(FLASH_TLM_BLANKCHECK, 0));     /* no Flash between the aliases */
+  }
+#endif /* STM32L5xx_512_0x08_0x0C */
+
+  rc = (FlashBlank((const unsigned char *)adr, sz, pat) != sz) ? 1 : 0;
+
+  return (FLASH_TLM_RET(FLASH_TLM_BLANKCHECK, rc));
+}
+#endif /* FLASH_MEM && FLASH_VERIFY */
+
 #if defined FLASH_OPT
 int BlankCheck (unsigned long adr, unsigned long sz, unsigned char pat) {
   /* For OPT algorithm Flash is always erased */
@@ -477,15 +693,13 @@ int BlankCheck (unsigned long adr, unsigned long sz, unsigned char pat) {
 #if defined FLASH_MEM
 int EraseChip (void)
 {
-  *pFlashSR = FLASH_PGERR;                               /* Reset Error Flags */
-
-  *pFlashCR  = (FLASH_CR_MER1 | FLASH_CR_MER2);          /* Bank A/B mass erase enabled */
-  *pFlashCR |=  FLASH_CR_STRT;                           /* Start erase */
-  DSB();
+  FLASH_TLM_BEGIN(FLASH_TLM_ERASECHIP, 0, 0);
 
-  while (*pFlashSR & FLASH_SR_BSY);                      /* Wait until operation is finished */
+  if (StartEraseChip() != 0) {
+    return (FLASH_TLM_RET(FLASH_TLM_ERASECHIP, 1));      /* Failed */
+  }
 
-  return (0);                                            /* Done */
+  return (FLASH_TLM_RET(FLASH_TLM_ERASECHIP, WaitOperation()));  /* Wait until operation is finished */
 }
 #endif /* FLASH_MEM */
 
@@ -533,12 +747,92 @@ int EraseChip (void) {
 
 #if defined FLASH_MEM
 int EraseSector (unsigned long adr)
+{
+  FLASH_TLM_BEGIN(FLASH_TLM_ERASESECTOR, adr, 0);
+
+  if (StartErase(adr) != 0) {
+    return (FLASH_TLM_RET(FLASH_TLM_ERASESECTOR, 1));    /* Failed */
+  }
+
+  return (FLASH_TLM_RET(FLASH_TLM_ERASESECTOR, WaitOperation()));  /* Wait until operation is finished */
+}
+#endif /* FLASH_MEM */
+
+#if defined FLASH_OPT
+int EraseSector (unsigned long adr) {
+  /* erase sector is not needed for Flash Option bytes */
+
+  (void)adr;
+
+  return (0);                                              /* Done */
+}
+#endif /* FLASH_OPT */
+
+
+/*
+ *  Start Erase of complete Flash Memory
+ *    Return Value:   0 - OK,  1 - Failed
+ *    Completion is checked with PollOperation
+ */
+
+#if defined FLASH_MEM
+int StartEraseChip (void)
+{
+  if (WaitOperation() != OP_DONE) {
+    return (1);                                          /* previous operation failed */
+  }
+
+#if defined STM32L5xx_512_0x08_0x0C
+  if (SelectFlashRegs(gFlashBase | FLASH_S_OFS) == 1U)
+  {                                                      /* secure pages are erased via FLASH_SECCR */
+    StartMassErase();
+    gFlashOp = FLASH_OP_MASS_S;                          /* non-secure erase is started by PollOperation */
+    return (0);
+  }
+
+  SelectFlashRegs(gFlashBase);                           /* non-secure pages are erased via FLASH_NSCR */
+#endif /* STM32L5xx_512_0x08_0x0C */
+
+  StartMassErase();
+  gFlashOp = FLASH_OP_ERASE;
+
+  return (0);                                            /* Started */
+}
+#endif /* FLASH_MEM */
+
+
+/*
+ *  Start Erase of Sector in Flash Memory
+ *    Parameter:      adr:  Sector Address
+ *    Return Value:   0 - OK,  1 - Failed
+ *    Completion is checked with PollOperation
+ */
+
+#if defined FLASH_MEM
+int StartErase (unsigned long adr)
 {
   u32 b, p;
+#if defined STM32L5xx_512_0x08_0x0C
+  u32 s;
+#endif /* STM32L5xx_512_0x08_0x0C */
 
-  adr &= 0x08FFFFFF;                                     /* map 0x0C000000 to 0x08000000 */
+  if (WaitOperation() != OP_DONE) {
+    return (1);                                          /* previous operation failed */
+  }
+
+#if defined STM32L5xx_512_0x08_0x0C
+  if (IsFlashGap(adr) == 1U) {
+    return (0);                                          /* no Flash between the aliases */
+  }
+  s = SelectFlashRegs(adr);                              /* registers of the used alias */
+#endif /* STM32L5xx_512_0x08_0x0C */
+
+  adr &= FLASH_NS_MSK;                                   /* map 0x0C000000 to 0x08000000 */
   b = GetFlashBankNum(adr);                              /* Get Bank Number 0..1  */
   p = GetFlashPageNum(adr);                              /* Get Page Number 0..127 */
+#if defined STM32L5xx_512_0x08_0x0C
+  SetFlashPageSecurity(b, p, s);                         /* page security follows the alias */
+#endif /* STM32L5xx_512_0x08_0x0C */
 
   *pFlashSR  = FLASH_PGERR;                              /* Reset Error Flags */
 
@@ -548,26 +842,51 @@ int EraseSector (unsigned long adr)
   *pFlashCR |=  FLASH_CR_STRT;                           /* Start Erase */
   DSB();
 
-  while (*pFlashSR & FLASH_SR_BSY);                      /* Wait until operation is finished */
+  gFlashOp = FLASH_OP_ERASE;
+
+  return (0);                                            /* Started */
+}
+#endif /* FLASH_MEM */
+
+
+/*
+ *  Poll started Operation
+ *    Return Value:   OP_DONE, OP_BUSY, OP_ERROR
+ */
+
+#if defined FLASH_MEM
+int PollOperation (void)
+{
+  if (gFlashOp == FLASH_OP_NONE) {
+    return (OP_DONE);                                    /* nothing started */
+  }
+
+  if (*pFlashSR & FLASH_SR_BSY) {
+    return (OP_BUSY);                                    /* operation in progress */
+  }
 
   if (*pFlashSR & FLASH_PGERR) {                         /* Check for Error */
+    FLASH_TLM_ERR(*pFlashSR & FLASH_PGERR);
     *pFlashSR  = FLASH_PGERR;                            /* Reset Error Flags */
-    return (1);                                          /* Failed */
+    gFlashOp   = FLASH_OP_NONE;
+    return (OP_ERROR);                                   /* Failed */
   }
 
-  return (0);                                            /* Done */
-}
-#endif /* FLASH_MEM */
-
-#if defined FLASH_OPT
-int EraseSector (unsigned long adr) {
-  /* erase sector is not needed for Flash Option bytes */
+#if defined STM32L5xx_512_0x08_0x0C
+  if (gFlashOp == FLASH_OP_MASS_S)
+  {                                                      /* secure pages done, erase non-secure pages */
+    SelectFlashRegs(gFlashBase);
+    StartMassErase();
+    gFlashOp = FLASH_OP_ERASE;
+    return (OP_BUSY);
+  }
+#endif /* STM32L5xx_512_0x08_0x0C */
 
-  (void)adr;
+  gFlashOp = FLASH_OP_NONE;
 
-  return (0);                                              /* Done */
+  return (OP_DONE);                                      /* Done */
 }
-#endif /* FLASH_OPT */
+#endif /* FLASH_MEM */
 
 
 /*
@@ -581,6 +900,21 @@ int EraseSector (unsigned long adr) {
 #if defined FLASH_MEM
 int ProgramPage (unsigned long adr, unsigned long sz, unsigned char *buf)
 {
+#if defined STM32L5xx_512_0x08_0x0C
+  u32 s;
+#endif /* STM32L5xx_512_0x08_0x0C */
+
+  FLASH_TLM_BEGIN(FLASH_TLM_PROGRAMPAGE, adr, sz);
+
+  if (WaitOperation() != OP_DONE) {
+    return (FLASH_TLM_RET(FLASH_TLM_PROGRAMPAGE, 1));    /* started erase failed */
+  }
+
+#if defined STM32L5xx_512_0x08_0x0C
+  s = SelectFlashRegs(adr);                              /* registers of the used alias */
+  SetFlashPageSecurity(GetFlashBankNum(adr & FLASH_NS_MSK),
+                       GetFlashPageNum(adr & FLASH_NS_MSK), s);
+#endif /* STM32L5xx_512_0x08_0x0C */
 
   sz = (sz + 7) & ~7U;                                   /* Adjust size for two words */
 
@@ -602,11 +936,13 @@ int ProgramPage (unsigned long adr, unsigned long sz, unsigned char *buf)
                          (*(buf+7) << 24) );             /* Program the second word of the Double Word */
     DSB();
 
-    while (*pFlashSR & FLASH_SR_BSY);                    /* Wait until operation is finished */
+    FLASH_TLM_SPIN(*pFlashSR & FLASH_SR_BSY);            /* Wait until operation is finished */
 
     if (*pFlashSR & FLASH_PGERR) {                       /* Check for Error */
+      FLASH_TLM_ERR(*pFlashSR & FLASH_PGERR);
       *pFlashSR  = FLASH_PGERR;                          /* Reset Error Flags */
-      return (1);                                        /* Failed */
+      *pFlashCR  = 0U;                                   /* Reset CR */
+      return (FLASH_TLM_RET(FLASH_TLM_PROGRAMPAGE, 1));  /* Failed */
     }
 
     adr += 8;                                            /* Next DoubleWord */
@@ -616,7 +952,7 @@ int ProgramPage (unsigned long adr, unsigned long sz, unsigned char *buf)
 
   *pFlashCR = 0U;                                       /* Reset CR */
 
-  return (0);
+  return (FLASH_TLM_RET(FLASH_TLM_PROGRAMPAGE, 0));
 }
 #endif /* FLASH_MEM */
 
@@ -671,20 +1007,20 @@ int ProgramPage (unsigned long adr, unsigned long sz, unsigned char *buf)
 
   FLASH->NSSR  = FLASH_PGERR;                              /* Reset Error Flags */
 
-  FLASH->OPTR         = (optr         & 0x9F7F77FFU) | ~(0x9F7F77FFU);
-  FLASH->NSBOOTADD0R  = (nsbootadd0r  & 0xFFFFFF80U) | ~(0xFFFFFF80U);
-  FLASH->NSBOOTADD1R  = (nsbootadd1r  & 0xFFFFFF80U) | ~(0xFFFFFF80U);
-  FLASH->WRP1AR       = (wrp1ar       & 0x007F007FU) | ~(0x007F007FU);
-  FLASH->WRP1BR       = (wrp1br       & 0x007F007FU) | ~(0x007F007FU);
-  FLASH->WRP2AR       = (wrp2ar       & 0x007F007FU) | ~(0x007F007FU);
-  FLASH->WRP2BR       = (wrp2br       & 0x007F007FU) | ~(0x007F007FU);
+  FLASH->OPTR         = (optr         & FLASH_OPTR_MSK      ) | ~(FLASH_OPTR_MSK      );
+  FLASH->NSBOOTADD0R  = (nsbootadd0r  & FLASH_NSBOOTADD_MSK ) | ~(FLASH_NSBOOTADD_MSK );
+  FLASH->NSBOOTADD1R  = (nsbootadd1r  & FLASH_NSBOOTADD_MSK ) | ~(FLASH_NSBOOTADD_MSK );
+  FLASH->WRP1AR       = (wrp1ar       & FLASH_WRP_MSK       ) | ~(FLASH_WRP_MSK       );
+  FLASH->WRP1BR       = (wrp1br       & FLASH_WRP_MSK       ) | ~(FLASH_WRP_MSK       );
+  FLASH->WRP2AR       = (wrp2ar       & FLASH_WRP_MSK       ) | ~(FLASH_WRP_MSK       );
+  FLASH->WRP2BR       = (wrp2br       & FLASH_WRP_MSK       ) | ~(FLASH_WRP_MSK       );
   if (GetFlashSecureMode() == 1U)
   {                                                        /* Flash secure */
-  FLASH->SECBOOTADD0R = (secbootadd0r & 0xFFFFFF83U) | ~(0xFFFFFF83U);  /* not sure if BOOT_LOCK is 1 ore 2 bits. docu says 1 but it seems to be 2 */
-  FLASH->SECWM1R2     = (secwm1r2     & 0x807F0000U) | ~(0x807F0000U);
-  FLASH->SECWM2R2     = (secwm2r2     & 0x807F0000U) | ~(0x807F0000U);
-  FLASH->SECWM1R1     = (secwm1r1     & 0x007F007FU) | ~(0x007F007FU);
-  FLASH->SECWM2R1     = (secwm2r1     & 0x007F007FU) | ~(0x007F007FU);
+  FLASH->SECBOOTADD0R = (secbootadd0r & FLASH_SECBOOTADD_MSK) | ~(FLASH_SECBOOTADD_MSK); /* not sure if BOOT_LOCK is 1 ore 2 bits. docu says 1 but it seems to be 2 */
+  FLASH->SECWM1R2     = (secwm1r2     & FLASH_SECWMR2_MSK   ) | ~(FLASH_SECWMR2_MSK   );
+  FLASH->SECWM2R2     = (secwm2r2     & FLASH_SECWMR2_MSK   ) | ~(FLASH_SECWMR2_MSK   );
+  FLASH->SECWM1R1     = (secwm1r1     & FLASH_SECWMR1_MSK   ) | ~(FLASH_SECWMR1_MSK   );
+  FLASH->SECWM2R1     = (secwm2r1     & FLASH_SECWMR1_MSK   ) | ~(FLASH_SECWMR1_MSK   );
   }
   DSB();
 
@@ -711,6 +1047,19 @@ int ProgramPage (unsigned long adr, unsigned long sz, unsigned char *buf)
  *    Return Value:   (adr+sz) - OK, Failed Address
  */
 
+#if defined FLASH_MEM && defined FLASH_VERIFY
+unsigned long Verify (unsigned long adr, unsigned long sz, unsigned char *buf)
+{
+  FLASH_TLM_BEGIN(FLASH_TLM_VERIFY, adr, sz);
+
+  if (WaitOperation() != OP_DONE) {
+    return (FLASH_TLM_RET_ADR(FLASH_TLM_VERIFY, adr, adr + sz));   /* started erase failed */
+  }
+
+  return (FLASH_TLM_RET_ADR(FLASH_TLM_VERIFY, adr + FlashCompare((const unsigned char *)adr, buf, sz), adr + sz));
+}
+#endif /* FLASH_MEM && FLASH_VERIFY */
+
 #ifdef FLASH_OPT
 unsigned long Verify (unsigned long adr, unsigned long sz, unsigned char *buf)
 {
@@ -744,53 +1093,53 @@ unsigned long Verify (unsigned long adr, unsigned long sz, unsigned char *buf)
   wrp2br       = (u32)((*(buf+44)) | (*(buf+44+1) <<  8) | (*(buf+44+2) << 16) | (*(buf+44+3) << 24) );
 
   /* Fail address returns the number of the OPT word passed with the assembler file */
-  if ((FLASH->OPTR         & 0x9F7F77FF) != (optr         & 0x9F7F77FF)) {    /* Check OPTR values */
+  if ((FLASH->OPTR         & FLASH_OPTR_MSK      ) != (optr         & FLASH_OPTR_MSK      )) { /* Check OPTR values */
     return (adr + 0);
   }
 
-  if ((FLASH->NSBOOTADD0R  & 0xFFFFFF80) != (nsbootadd0r  & 0xFFFFFF80)) {    /* Check NSBOOTADD0R values */
+  if ((FLASH->NSBOOTADD0R  & FLASH_NSBOOTADD_MSK ) != (nsbootadd0r  & FLASH_NSBOOTADD_MSK )) { /* Check NSBOOTADD0R values */
     return (adr + 3);
   }
 
-  if ((FLASH->NSBOOTADD1R  & 0xFFFFFF80) != (nsbootadd1r  & 0xFFFFFF80)) {    /* Check NSBOOTADD1R values */
+  if ((FLASH->NSBOOTADD1R  & FLASH_NSBOOTADD_MSK ) != (nsbootadd1r  & FLASH_NSBOOTADD_MSK )) { /* Check NSBOOTADD1R values */
     return (adr + 4);
   }
 
-  if ((FLASH->WRP1AR       & 0x007F007F) != (wrp1ar       & 0x007F007F)) {    /* Check WRP1AR values */
+  if ((FLASH->WRP1AR       & FLASH_WRP_MSK       ) != (wrp1ar       & FLASH_WRP_MSK       )) { /* Check WRP1AR values */
     return (adr + 7);
   }
 
-  if ((FLASH->WRP1BR       & 0x007F007F) != (wrp1br       & 0x007F007F)) {    /* Check WRP1BR values */
+  if ((FLASH->WRP1BR       & FLASH_WRP_MSK       ) != (wrp1br       & FLASH_WRP_MSK       )) { /* Check WRP1BR values */
     return (adr + 8);
   }
 
-  if ((FLASH->WRP2AR       & 0x007F007F) != (wrp2ar       & 0x007F007F)) {    /* Check WRP2AR values */
+  if ((FLASH->WRP2AR       & FLASH_WRP_MSK       ) != (wrp2ar       & FLASH_WRP_MSK       )) { /* Check WRP2AR values */
     return (adr + 10);
   }
 
-  if ((FLASH->WRP2BR       & 0x007F007F) != (wrp2br       & 0x007F007F)) {    /* Check WRP2BR values */
+  if ((FLASH->WRP2BR       & FLASH_WRP_MSK       ) != (wrp2br       & FLASH_WRP_MSK       )) { /* Check WRP2BR values */
     return (adr + 11);
   }
 
 if (GetFlashSecureMode() == 1U)
 {                                                      /* Flash secure */
-  if ((FLASH->SECBOOTADD0R & 0xFFFFFF83) != (secbootadd0r & 0xFFFFFF83)) {    /* Check SECBOOTADD0R values */
+  if ((FLASH->SECBOOTADD0R & FLASH_SECBOOTADD_MSK) != (secbootadd0r & FLASH_SECBOOTADD_MSK)) { /* Check SECBOOTADD0R values */
     return (adr + 5);
   }
 
-  if ((FLASH->SECWM1R2     & 0x807F0000) != (secwm1r2     & 0x807F0000)) {    /* Check SECWM1R2 values */
+  if ((FLASH->SECWM1R2     & FLASH_SECWMR2_MSK   ) != (secwm1r2     & FLASH_SECWMR2_MSK   )) { /* Check SECWM1R2 values */
     return (adr + 1);
   }
 
-  if ((FLASH->SECWM2R2     & 0x807F0000) != (secwm2r2     & 0x807F0000)) {    /* Check SECWM2R2 values */
+  if ((FLASH->SECWM2R2     & FLASH_SECWMR2_MSK   ) != (secwm2r2     & FLASH_SECWMR2_MSK   )) { /* Check SECWM2R2 values */
     return (adr + 2);
   }
 
-  if ((FLASH->SECWM1R1     & 0x007F007F) != (secwm1r1     & 0x007F007F)) {    /* Check SECWM1R1 values */
+  if ((FLASH->SECWM1R1     & FLASH_SECWMR1_MSK   ) != (secwm1r1     & FLASH_SECWMR1_MSK   )) { /* Check SECWM1R1 values */
     return (adr + 6);
   }
 
-  if ((FLASH->SECWM2R1     & 0x007F007F) != (secwm2r1     & 0x007F007F)) {    /* Check SECWM2R1 values */
+  if ((FLASH->SECWM2R1     & FLASH_SECWMR1_MSK   ) != (secwm2r1     & FLASH_SECWMR1_MSK   )) { /* Check SECWM2R1 values */
     return (adr + 9);
   }
 }
@@ -0,0 +1,206 @@
+/* -----------------------------------------------------------------------------
+ * Copyright (c) 2026 ARM Ltd.
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software. Permission is granted to anyone to use this
+ * software for any purpose, including commercial applications, and to alter
+ * it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V1.00
+ *
+ * Project:      Host unit test and benchmark of FlashCompare.h
+ * --------------------------------------------------------------------------- */
+
+/* Build and run on the host:
+ *   gcc -O2 -Wall -Wextra -o FlashCompareTest FlashCompareTest.c
+ *   ./FlashCompareTest          unit tests
+ *   ./FlashCompareTest bench    unit tests and benchmark
+ *
+ * The unit tests compare FlashCompare and FlashBlank with a byte loop for
+ * all Flash and buffer offsets 0..7, sizes 0..80 and every mismatch
+ * position (first, inside a 16-byte block, in the byte tail). The exit
+ * code is 1 if a test failed.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "../FlashCompare.h"
+
+#define MAX_OFS    8
+#define MAX_SZ     80
+#define BENCH_SZ   (1024UL * 1024UL)
+#define BENCH_RUN  64
+
+static unsigned char MemBuf[MAX_SZ + MAX_OFS + 16];
+static unsigned char DatBuf[MAX_SZ + MAX_OFS + 16];
+static unsigned char BenchMem[BENCH_SZ + 16];
+static unsigned char BenchDat[BENCH_SZ + 16];
+
+static unsigned long Fails;
+
+/* Reference: offset of first mismatch, sz - Match */
+static unsigned long RefCompare (const unsigned char *mem, const unsigned char *buf, unsigned long sz) {
+  unsigned long i;
+
+  for (i = 0; i < sz; i++) {
+    if (mem[i] != buf[i]) {
+      return (i);
+    }
+  }
+  return (sz);
+}
+
+static unsigned long RefBlank (const unsigned char *mem, unsigned long sz, unsigned char pat) {
+  unsigned long i;
+
+  for (i = 0; i < sz; i++) {
+    if (mem[i] != pat) {
+      return (i);
+    }
+  }
+  return (sz);
+}
+
+static void Check (const char *fnc, unsigned long mo, unsigned long bo, unsigned long sz,
+                   long pos, unsigned long res, unsigned long ref) {
+  if (res != ref) {
+    if (Fails < 20) {
+      printf("FAIL %s mem+%lu buf+%lu size %lu mismatch %ld: %lu, expected %lu\n",
+             fnc, mo, bo, sz, pos, res, ref);
+    }
+    Fails++;
+  }
+}
+
+static void TestCompare (void) {
+  unsigned long mo, bo, sz, n;
+  long pos;
+  unsigned char *m, *b;
+
+  for (mo = 0; mo < MAX_OFS; mo++) {
+    for (bo = 0; bo < MAX_OFS; bo++) {
+      for (sz = 0; sz <= MAX_SZ; sz++) {
+        m = MemBuf + mo;
+        b = DatBuf + bo;
+        for (pos = -1; pos < (long)sz; pos++) {
+          for (n = 0; n < sz; n++) {
+            m[n] = (unsigned char)(n * 7 + 3);
+            b[n] = m[n];
+          }
+          m[sz] = 0x55;                    /* bytes behind the range must not be compared */
+          b[sz] = 0xAA;
+          if (pos >= 0) {
+            b[pos] ^= 0x80;
+            if ((pos + 5) < (long)sz) {
+              b[pos + 5] ^= 0x01;          /* second mismatch must not be reported */
+            }
+          }
+          Check("FlashCompare", mo, bo, sz, pos, FlashCompare(m, b, sz), RefCompare(m, b, sz));
+        }
+      }
+    }
+  }
+}
+
+static void TestBlank (void) {
+  static const unsigned char pat[] = { 0xFF, 0x00, 0xA5 };
+  unsigned long mo, sz, p;
+  long pos;
+  unsigned char *m;
+
+  for (p = 0; p < sizeof(pat); p++) {
+    for (mo = 0; mo < MAX_OFS; mo++) {
+      for (sz = 0; sz <= MAX_SZ; sz++) {
+        m = MemBuf + mo;
+        for (pos = -1; pos < (long)sz; pos++) {
+          memset(m, pat[p], sz);
+          m[sz] = (unsigned char)~pat[p];
+          if (pos >= 0) {
+            m[pos] ^= 0x10;
+          }
+          Check("FlashBlank", mo, 0, sz, pos, FlashBlank(m, sz, pat[p]), RefBlank(m, sz, pat[p]));
+        }
+      }
+    }
+  }
+}
+
+static double Seconds (clock_t t) {
+  return ((double)(clock() - t) / CLOCKS_PER_SEC);
+}
+
+static void Bench (void) {
+  static const unsigned long ofs[][2] = { {0, 0}, {0, 1}, {0, 2}, {1, 0}, {3, 5} };
+  volatile unsigned long sink = 0;
+  unsigned long i, r;
+  clock_t t;
+  double tk, tr;
+
+  for (i = 0; i < sizeof(BenchMem); i++) {
+    BenchMem[i] = (unsigned char)(i * 13);
+    BenchDat[i] = BenchMem[i];
+  }
+
+  printf("%-14s %-10s %10s %10s %8s\n", "function", "mem/buf", "kernel MB/s", "bytes MB/s", "speedup");
+  for (i = 0; i < (sizeof(ofs) / sizeof(ofs[0])); i++) {
+    memmove(BenchDat + ofs[i][1], BenchMem + ofs[i][0], BENCH_SZ);
+
+    t = clock();
+    for (r = 0; r < BENCH_RUN; r++) {
+      sink += FlashCompare(BenchMem + ofs[i][0], BenchDat + ofs[i][1], BENCH_SZ);
+    }
+    tk = Seconds(t);
+    t = clock();
+    for (r = 0; r < BENCH_RUN; r++) {
+      sink += RefCompare(BenchMem + ofs[i][0], BenchDat + ofs[i][1], BENCH_SZ);
+    }
+    tr = Seconds(t);
+    printf("%-14s %4lu/%-5lu %10.0f %10.0f %8.1f\n", "FlashCompare", ofs[i][0], ofs[i][1],
+           (BENCH_RUN * (BENCH_SZ / 1e6)) / tk, (BENCH_RUN * (BENCH_SZ / 1e6)) / tr, tr / tk);
+  }
+
+  memset(BenchMem, 0xFF, sizeof(BenchMem));
+  for (i = 0; i < 4; i++) {
+    t = clock();
+    for (r = 0; r < BENCH_RUN; r++) {
+      sink += FlashBlank(BenchMem + i, BENCH_SZ, 0xFF);
+    }
+    tk = Seconds(t);
+    t = clock();
+    for (r = 0; r < BENCH_RUN; r++) {
+      sink += RefBlank(BenchMem + i, BENCH_SZ, 0xFF);
+    }
+    tr = Seconds(t);
+    printf("%-14s %4lu/%-5s %10.0f %10.0f %8.1f\n", "FlashBlank", i, "-",
+           (BENCH_RUN * (BENCH_SZ / 1e6)) / tk, (BENCH_RUN * (BENCH_SZ / 1e6)) / tr, tr / tk);
+  }
+  (void)sink;
+}
+
+int main (int argc, char *argv[]) {
+
+  TestCompare();
+  TestBlank();
+  printf("FlashCompare.h: %lu failures\n", Fails);
+
+  if ((argc > 1) && (strcmp(argv[1], "bench") == 0)) {
+    Bench();
+  }
+
+  return ((Fails != 0) ? 1 : 0);
+}
@@ -0,0 +1,265 @@
+/* -----------------------------------------------------------------------------
+ * Copyright (c) 2026 ARM Ltd.
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software. Permission is granted to anyone to use this
+ * software for any purpose, including commercial applications, and to alter
+ * it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V1.00
+ *
+ * Project:      Host unit test of MX25LM51245G_ParseSFDP
+ * --------------------------------------------------------------------------- */
+
+/* Build and run on the host:
+ *   gcc -O2 -Wall -Wextra -IStub -I../STM32L562_OSPI_MX25L51245G/Drivers/BSP/Components/mx25lm51245g -o SfdpParseTest SfdpParseTest.c
+ *   ./SfdpParseTest
+ *
+ * The component is built with the HAL stub of Stub/stm32L5xx_hal.h. The
+ * SFDP blob follows the layout read from the MX25LM51245G: header with
+ * three parameter headers, Basic Flash Parameter Table (JESD216B, 20
+ * DWORDs), 4-byte Address Instruction Table and xSPI Profile 1.0 Table.
+ * The values are encoded per JESD216 from the datasheet parameters, it is
+ * not a dump of a part. Variants test older revisions, a missing table,
+ * a bad signature and truncated data. The exit code is 1 if a test failed.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mx25lm51245g.c"
+
+#define BFPT_OFS   0x30U
+#define BFPT_HDR   0x08U
+#define PROF_OFS   0xD0U
+
+static uint8_t Sfdp[MX25LM51245G_SFDP_SIZE];
+
+static unsigned long Fails;
+
+static void PutDword (uint32_t ofs, uint32_t val) {
+  Sfdp[ofs     ] = (uint8_t) val;
+  Sfdp[ofs + 1U] = (uint8_t)(val >>  8);
+  Sfdp[ofs + 2U] = (uint8_t)(val >> 16);
+  Sfdp[ofs + 3U] = (uint8_t)(val >> 24);
+}
+
+static void PutHeader (uint32_t n, uint32_t id, uint32_t len, uint32_t ptr) {
+  uint8_t *hdr = &Sfdp[8U + (8U * n)];
+
+  hdr[0] = (uint8_t) id;
+  hdr[1] = 0x00U;                      /* minor revision */
+  hdr[2] = 0x01U;                      /* major revision */
+  hdr[3] = (uint8_t) len;              /* DWORDs */
+  hdr[4] = (uint8_t) ptr;
+  hdr[5] = (uint8_t)(ptr >>  8);
+  hdr[6] = (uint8_t)(ptr >> 16);
+  hdr[7] = (uint8_t)(id  >>  8);
+}
+
+/* MX25LM51245G SFDP: BFPT, 4BAIT, xSPI Profile 1.0 */
+static void MakeSfdp (void) {
+  memset(Sfdp, 0xFF, sizeof(Sfdp));
+
+  PutDword(0x00U, 0x50444653U);        /* "SFDP" */
+  Sfdp[4] = 0x06U;                     /* JESD216B */
+  Sfdp[5] = 0x01U;
+  Sfdp[6] = 0x02U;                     /* 3 parameter headers */
+  Sfdp[7] = 0xFFU;
+  PutHeader(0U, 0xFF00U, 20U, BFPT_OFS);
+  PutHeader(1U, 0xFF84U,  2U, 0xC0U);
+  PutHeader(2U, 0xFF05U,  5U, PROF_OFS);
+
+  memset(&Sfdp[BFPT_OFS], 0x00, 20U * 4U);
+  PutDword(BFPT_OFS + 0x00U, 0xFFF320E5U);      /* DW1: 4K erase 0x20, 4-byte address */
+  PutDword(BFPT_OFS + 0x04U, 0x1FFFFFFFU);      /* DW2: 512 Mbit */
+  PutDword(BFPT_OFS + 0x1CU, 0xD810200CU);      /* DW8: 4K 0x20, 64K 0xD8 */
+  PutDword(BFPT_OFS + 0x20U, 0x00000000U);      /* DW9: no erase types 3 and 4 */
+  PutDword(BFPT_OFS + 0x24U, (3U << 0) |        /* DW10: max = 8 * typical */
+                             (2U << 4) | (1U << 9) |    /* 4K:  3 * 16 ms */
+                             (7U << 11) | (1U << 16));  /* 64K: 8 * 16 ms */
+  PutDword(BFPT_OFS + 0x28U, 0x00000081U);      /* DW11: 256 byte page */
+  PutDword(BFPT_OFS + 0x44U, 0x20000000U);      /* DW18: inverted command extension */
+
+  PutDword(0xC0U, 0x00000000U);
+  PutDword(0xC4U, 0x21DCFF21U);
+
+  PutDword(PROF_OFS + 0x00U, 0x0000EE00U);      /* DW1: octal DTR read 0xEE */
+  PutDword(PROF_OFS + 0x04U, 0x00000000U);
+  PutDword(PROF_OFS + 0x08U, 0x00000000U);
+  PutDword(PROF_OFS + 0x0CU, 20U << 7);         /* DW4: 200 MHz */
+  PutDword(PROF_OFS + 0x10U, (10U << 7) | (14U << 17) | (16U << 27));  /* DW5: 100, 133, 166 MHz */
+}
+
+static void Check (const char *test, const char *name, uint32_t val, uint32_t exp) {
+  if (val != exp) {
+    printf("FAIL %s: %s 0x%08X, expected 0x%08X\n", test, name, (unsigned)val, (unsigned)exp);
+    Fails++;
+  }
+}
+
+static void CheckErase (const char *test, const MX25LM51245G_SFDP_t *info, const uint32_t exp[][3]) {
+  uint32_t i;
+
+  for (i = 0U; i < MX25LM51245G_SFDP_ERASE_NUM; i++) {
+    Check(test, "EraseSize",    info->EraseSize[i],    exp[i][0]);
+    Check(test, "EraseCmd",     info->EraseCmd[i],     exp[i][1]);
+    Check(test, "EraseMaxTime", info->EraseMaxTime[i], exp[i][2]);
+  }
+}
+
+/* Compiled-in values */
+static const uint32_t EraseDefault[MX25LM51245G_SFDP_ERASE_NUM][3] = {
+  { 0x1000U,  0x20U, MX25LM51245G_SUBSECTOR_4K_ERASE_MAX_TIME },
+  { 0x10000U, 0xD8U, MX25LM51245G_SECTOR_ERASE_MAX_TIME       },
+  { 0U, 0U, 0U },
+  { 0U, 0U, 0U }
+};
+
+static void CheckDefault (const char *test, const MX25LM51245G_SFDP_t *info) {
+  Check(test, "FlashSize", info->FlashSize, MX25LM51245G_FLASH_SIZE);
+  Check(test, "PageSize",  info->PageSize,  MX25LM51245G_PAGE_SIZE);
+  Check(test, "ReadCmd",   info->ReadCmd,   MX25LM51245G_OCTA_READ_DTR_CMD);
+  Check(test, "MaxFreq",   info->MaxFreq,   0U);
+  CheckErase(test, info, EraseDefault);
+}
+
+static void TestFull (void) {
+  static const uint32_t erase[MX25LM51245G_SFDP_ERASE_NUM][3] = {
+    { 0x1000U,  0x20U,  384U },
+    { 0x10000U, 0xD8U, 1024U },
+    { 0U, 0U, 0U },
+    { 0U, 0U, 0U }
+  };
+  MX25LM51245G_SFDP_t info;
+
+  MakeSfdp();
+  Check("full", "return", (uint32_t)MX25LM51245G_ParseSFDP(Sfdp, sizeof(Sfdp), &info), MX25LM51245G_OK);
+  Check("full", "FlashSize", info.FlashSize, 0x04000000U);
+  Check("full", "PageSize",  info.PageSize,  256U);
+  Check("full", "ReadCmd",   info.ReadCmd,   0xEE11U);
+  Check("full", "Dummy100",  info.ReadDummyCycles[0], 10U);
+  Check("full", "Dummy133",  info.ReadDummyCycles[1], 14U);
+  Check("full", "Dummy166",  info.ReadDummyCycles[2], 16U);
+  Check("full", "Dummy200",  info.ReadDummyCycles[3], 20U);
+  Check("full", "MaxFreq",   info.MaxFreq,   200U);
+  CheckErase("full", &info, erase);
+}
+
+/* JESD216 (9 DWORDs): erase types, but no erase times and no page size */
+static void TestJesd216 (void) {
+  MX25LM51245G_SFDP_t info;
+
+  MakeSfdp();
+  Sfdp[BFPT_HDR + 3U] = 9U;
+  Check("jesd216", "return", (uint32_t)MX25LM51245G_ParseSFDP(Sfdp, sizeof(Sfdp), &info), MX25LM51245G_OK);
+  Check("jesd216", "FlashSize", info.FlashSize, 0x04000000U);
+  Check("jesd216", "MaxFreq",   info.MaxFreq,   0U);
+  CheckErase("jesd216", &info, EraseDefault);
+}
+
+/* 32K and 256K erase types: no compiled-in time, SFDP times only */
+static void TestEraseTypes (void) {
+  static const uint32_t erase[MX25LM51245G_SFDP_ERASE_NUM][3] = {
+    { 0x8000U,  0x52U,  384U },
+    { 0x10000U, 0xD8U, 1024U },
+    { 0U, 0U, 0U },
+    { 0x40000U, 0xDDU, 16000U }
+  };
+  MX25LM51245G_SFDP_t info;
+
+  MakeSfdp();
+  PutDword(BFPT_OFS + 0x1CU, 0xD810520FU);
+  PutDword(BFPT_OFS + 0x20U, 0xDD120000U);
+  PutDword(BFPT_OFS + 0x24U, (3U << 0) | (2U << 4) | (1U << 9) | (7U << 11) | (1U << 16) |
+                             (1U << 25) | (3U << 30));  /* 256K: 2 * 1 s */
+  Check("types", "return", (uint32_t)MX25LM51245G_ParseSFDP(Sfdp, sizeof(Sfdp), &info), MX25LM51245G_OK);
+  CheckErase("types", &info, erase);
+}
+
+/* JESD216 with the erase types above: compiled-in maximum time of 64K only */
+static void TestEraseTypes9 (void) {
+  static const uint32_t erase[MX25LM51245G_SFDP_ERASE_NUM][3] = {
+    { 0x8000U,  0x52U, 0U },
+    { 0x10000U, 0xD8U, MX25LM51245G_SECTOR_ERASE_MAX_TIME },
+    { 0U, 0U, 0U },
+    { 0x40000U, 0xDDU, 0U }
+  };
+  MX25LM51245G_SFDP_t info;
+
+  MakeSfdp();
+  Sfdp[BFPT_HDR + 3U] = 9U;
+  PutDword(BFPT_OFS + 0x1CU, 0xD810520FU);
+  PutDword(BFPT_OFS + 0x20U, 0xDD120000U);
+  Check("types9", "return", (uint32_t)MX25LM51245G_ParseSFDP(Sfdp, sizeof(Sfdp), &info), MX25LM51245G_OK);
+  CheckErase("types9", &info, erase);
+}
+
+/* Density of more than 2 Gbit: 2^N bits */
+static void TestDensity (void) {
+  MX25LM51245G_SFDP_t info;
+
+  MakeSfdp();
+  PutDword(BFPT_OFS + 0x04U, 0x80000021U);
+  (void)MX25LM51245G_ParseSFDP(Sfdp, sizeof(Sfdp), &info);
+  Check("density", "FlashSize", info.FlashSize, 0x40000000U);
+}
+
+/* No xSPI Profile 1.0 Table: no octal DTR read timing */
+static void TestNoProfile (void) {
+  MX25LM51245G_SFDP_t info;
+
+  MakeSfdp();
+  Sfdp[6] = 0x01U;                     /* 2 parameter headers */
+  Check("noprofile", "return", (uint32_t)MX25LM51245G_ParseSFDP(Sfdp, sizeof(Sfdp), &info), MX25LM51245G_OK);
+  Check("noprofile", "ReadCmd",  info.ReadCmd,  MX25LM51245G_OCTA_READ_DTR_CMD);
+  Check("noprofile", "Dummy100", info.ReadDummyCycles[0], 0U);
+  Check("noprofile", "MaxFreq",  info.MaxFreq,  0U);
+}
+
+/* No SFDP: compiled-in values */
+static void TestInvalid (void) {
+  MX25LM51245G_SFDP_t info;
+
+  MakeSfdp();
+  Check("size0", "return", (uint32_t)MX25LM51245G_ParseSFDP(Sfdp, 0U, &info), (uint32_t)MX25LM51245G_ERROR);
+  CheckDefault("size0", &info);
+
+  Check("truncated", "return", (uint32_t)MX25LM51245G_ParseSFDP(Sfdp, BFPT_OFS + 16U, &info), (uint32_t)MX25LM51245G_ERROR);
+  CheckDefault("truncated", &info);
+
+  Sfdp[0] = 0x00U;
+  Check("signature", "return", (uint32_t)MX25LM51245G_ParseSFDP(Sfdp, sizeof(Sfdp), &info), (uint32_t)MX25LM51245G_ERROR);
+  CheckDefault("signature", &info);
+
+  memset(Sfdp, 0xFF, sizeof(Sfdp));
+  Check("erased", "return", (uint32_t)MX25LM51245G_ParseSFDP(Sfdp, sizeof(Sfdp), &info), (uint32_t)MX25LM51245G_ERROR);
+  CheckDefault("erased", &info);
+}
+
+int main (void) {
+
+  TestFull();
+  TestJesd216();
+  TestEraseTypes();
+  TestEraseTypes9();
+  TestDensity();
+  TestNoProfile();
+  TestInvalid();
+  printf("MX25LM51245G_ParseSFDP: %lu failures\n", Fails);
+
+  return ((Fails != 0) ? 1 : 0);
+}
@@ -0,0 +1,155 @@
+/* -----------------------------------------------------------------------------
+ * Copyright (c) 2026 ARM Ltd.
+ *
+ * This software is provided 'as-is', without any express or implied warranty.
+ * In no event will the authors be held liable for any damages arising from
+ * the use of this software. Permission is granted to anyone to use this
+ * software for any purpose, including commercial applications, and to alter
+ * it and redistribute it freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ *
+ * $Date:        18. October 2026
+ * $Revision:    V1.00
+ *
+ * Project:      Host stub of the STM32L5xx HAL for the MX25LM51245G component
+ * --------------------------------------------------------------------------- */
+
+/* Types, constants and functions of the HAL OSPI driver used by
+ * mx25lm51245g.c, so that the component builds on a host (SfdpParseTest.c).
+ * The OSPI functions fail: only the functions without OSPI access can be
+ * tested.
+ */
+
+#ifndef STM32L5xx_HAL_H
+#define STM32L5xx_HAL_H
+
+#include <stdint.h>
+
+#define UNUSED(x) ((void)(x))
+
+typedef enum {
+  HAL_OK    = 0x00U,
+  HAL_ERROR = 0x01U
+} HAL_StatusTypeDef;
+
+typedef struct {
+  uint32_t State;
+} OSPI_HandleTypeDef;
+
+typedef struct {
+  uint32_t OperationType;
+  uint32_t FlashId;
+  uint32_t Instruction;
+  uint32_t InstructionMode;
+  uint32_t InstructionSize;
+  uint32_t InstructionDtrMode;
+  uint32_t Address;
+  uint32_t AddressMode;
+  uint32_t AddressSize;
+  uint32_t AddressDtrMode;
+  uint32_t AlternateBytes;
+  uint32_t AlternateBytesMode;
+  uint32_t AlternateBytesSize;
+  uint32_t AlternateBytesDtrMode;
+  uint32_t DataMode;
+  uint32_t NbData;
+  uint32_t DataDtrMode;
+  uint32_t DummyCycles;
+  uint32_t DQSMode;
+  uint32_t SIOOMode;
+} OSPI_RegularCmdTypeDef;
+
+typedef struct {
+  uint32_t Match;
+  uint32_t Mask;
+  uint32_t MatchMode;
+  uint32_t AutomaticStop;
+  uint32_t Interval;
+} OSPI_AutoPollingTypeDef;
+
+typedef struct {
+  uint32_t TimeOutActivation;
+  uint32_t TimeOutPeriod;
+} OSPI_MemoryMappedTypeDef;
+
+#define HAL_OSPI_TIMEOUT_DEFAULT_VALUE    5000U
+
+#define HAL_OSPI_OPTYPE_COMMON_CFG        0U
+#define HAL_OSPI_OPTYPE_READ_CFG          1U
+#define HAL_OSPI_OPTYPE_WRITE_CFG         2U
+#define HAL_OSPI_FLASH_ID_1               0U
+#define HAL_OSPI_DUALQUAD_DISABLE         0U
+#define HAL_OSPI_DUALQUAD_ENABLE          1U
+
+#define HAL_OSPI_INSTRUCTION_1_LINE       1U
+#define HAL_OSPI_INSTRUCTION_8_LINES      4U
+#define HAL_OSPI_INSTRUCTION_8_BITS       0U
+#define HAL_OSPI_INSTRUCTION_16_BITS      1U
+#define HAL_OSPI_INSTRUCTION_DTR_DISABLE  0U
+#define HAL_OSPI_INSTRUCTION_DTR_ENABLE   1U
+
+#define HAL_OSPI_ADDRESS_NONE             0U
+#define HAL_OSPI_ADDRESS_1_LINE           1U
+#define HAL_OSPI_ADDRESS_8_LINES          4U
+#define HAL_OSPI_ADDRESS_24_BITS          2U
+#define HAL_OSPI_ADDRESS_32_BITS          3U
+#define HAL_OSPI_ADDRESS_DTR_DISABLE      0U
+#define HAL_OSPI_ADDRESS_DTR_ENABLE       1U
+
+#define HAL_OSPI_ALTERNATE_BYTES_NONE     0U
+
+#define HAL_OSPI_DATA_NONE                0U
+#define HAL_OSPI_DATA_1_LINE              1U
+#define HAL_OSPI_DATA_8_LINES             4U
+#define HAL_OSPI_DATA_DTR_DISABLE         0U
+#define HAL_OSPI_DATA_DTR_ENABLE          1U
+
+#define HAL_OSPI_DQS_DISABLE              0U
+#define HAL_OSPI_DQS_ENABLE               1U
+#define HAL_OSPI_SIOO_INST_EVERY_CMD      0U
+
+#define HAL_OSPI_MATCH_MODE_AND           0U
+#define HAL_OSPI_AUTOMATIC_STOP_ENABLE    1U
+#define HAL_OSPI_TIMEOUT_COUNTER_ENABLE   1U
+
+static __inline HAL_StatusTypeDef HAL_OSPI_Command (OSPI_HandleTypeDef *hospi, OSPI_RegularCmdTypeDef *cmd, uint32_t Timeout) {
+  (void)hospi; (void)cmd; (void)Timeout;
+  return (HAL_ERROR);
+}
+
+static __inline HAL_StatusTypeDef HAL_OSPI_Transmit (OSPI_HandleTypeDef *hospi, uint8_t *pData, uint32_t Timeout) {
+  (void)hospi; (void)pData; (void)Timeout;
+  return (HAL_ERROR);
+}
+
+static __inline HAL_StatusTypeDef HAL_OSPI_Receive (OSPI_HandleTypeDef *hospi, uint8_t *pData, uint32_t Timeout) {
+  (void)hospi; (void)pData; (void)Timeout;
+  return (HAL_ERROR);
+}
+
+static __inline HAL_StatusTypeDef HAL_OSPI_AutoPolling (OSPI_HandleTypeDef *hospi, OSPI_AutoPollingTypeDef *cfg, uint32_t Timeout) {
+  (void)hospi; (void)cfg; (void)Timeout;
+  return (HAL_ERROR);
+}
+
+static __inline HAL_StatusTypeDef HAL_OSPI_AutoPolling_IT (OSPI_HandleTypeDef *hospi, OSPI_AutoPollingTypeDef *cfg) {
+  (void)hospi; (void)cfg;
+  return (HAL_ERROR);
+}
+
+static __inline HAL_StatusTypeDef HAL_OSPI_MemoryMapped (OSPI_HandleTypeDef *hospi, OSPI_MemoryMappedTypeDef *cfg) {
+  (void)hospi; (void)cfg;
+  return (HAL_ERROR);
+}
+
+#endif /* STM32L5xx_HAL_H */